@@ -0,0 +1,211 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+// Times the simulator independent scheduler core (graph build, SH frame, P2P slot)
+// on synthetic node sets of 10 to 10,000 nodes and prints the time per frame.
+// A second table times the graph build for 1 to 8 threads (graphBuildThreads)
+// at 1k, 5k and 10k nodes and prints the speedup over the serial build. A third
+// table compares the spatial grid with the all-pairs distance test it replaced
+// at 100, 1k and 10k nodes and fails if their edge sets differ.
+//
+// Usage: schedulerCoreBenchmark [frames per measurement]
+
+#include "scheduler/core/SchedulerCore.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** @brief Random source for the policies backed by a seeded Mersenne twister. */
+class BenchmarkRandom: public IRandomSource
+{
+    public:
+        explicit BenchmarkRandom(unsigned seed) : engine(seed) {}
+        int uniformInt(int low, int high) override { return std::uniform_int_distribution<int>(low, high)(engine); }
+
+    protected:
+        std::mt19937 engine;
+};
+
+/** @brief Synthetic scenario: uniformly placed nodes with a fixed mean degree and random backlogs. */
+struct Scenario
+{
+    std::vector<int> nodeIds;
+    std::vector<NodePosition> positions;
+    std::vector<int> bufferStatusSH;
+    std::vector<int> bufferStatusP2P;
+    std::vector<std::vector<P2PDemand>> destinationsP2P;
+    std::vector<double> lastAssigned;
+    std::vector<bool> busy;
+
+    Scenario(int numNodes, double range, double meanDegree, unsigned seed) {
+        std::mt19937 engine(seed);
+        // Square area in which a node has meanDegree neighbours on average
+        double side = std::sqrt(numNodes * M_PI * range * range / meanDegree);
+        std::uniform_real_distribution<double> coordinate(0, side);
+        std::uniform_int_distribution<int> backlog(1, 5);
+        std::uniform_int_distribution<int> recipient(0, numNodes - 1);
+        for (int nodeId = 0; nodeId < numNodes; ++nodeId) {
+            nodeIds.push_back(nodeId);
+            positions.emplace_back(coordinate(engine), coordinate(engine), 0);
+            bufferStatusSH.push_back(backlog(engine));
+            bufferStatusP2P.push_back(0);
+            destinationsP2P.emplace_back();
+            for (int i = 0; i < 2; ++i) {
+                int other = recipient(engine);
+                if (other != nodeId) {
+                    int packets = backlog(engine);
+                    destinationsP2P.back().push_back(P2PDemand{other, packets});
+                    bufferStatusP2P.back() += packets;
+                }
+            }
+        }
+        lastAssigned.assign(numNodes, -1);
+        busy.assign(numNodes, false);
+    }
+};
+
+static double elapsedMicroseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Reference neighbour discovery: the distance test for every pair, as the scheduler did before the spatial grid
+static void collectPairsBruteForce(const std::vector<NodePosition>& positions, double range, std::vector<std::pair<int, int>>& pairs) {
+    pairs.clear();
+    for (int i = 0; i < (int)positions.size(); ++i) {
+        for (int j = i + 1; j < (int)positions.size(); ++j) {
+            if (positions[i].distance(positions[j]) <= range) {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 5;
+    const double range = 100000; // meters
+    const char *policiesSH[] = {"random", "maxWeight", "proportionalFair", "greedyColouring"};
+    const char *policiesP2P[] = {"random", "maxWeight", "proportionalFair", "matching"};
+
+    std::printf("%6s  %-16s  %-16s  %12s  %12s  %12s  %10s  %10s\n", "nodes", "SH policy", "P2P policy",
+            "graph [us]", "SH [us]", "P2P [us]", "SH tx", "P2P links");
+    for (int numNodes : {10, 100, 1000, 10000}) {
+        Scenario scenario(numNodes, range, 10, 1);
+        for (int policy = 0; policy < 4; ++policy) {
+            SchedulerCoreParameters parameters;
+            parameters.communicationRange = range;
+            parameters.frameSlots = 10;
+            parameters.slotDuration = 0.024;
+            parameters.maxP2PLinks = 50;
+            parameters.policySH = policiesSH[policy];
+            parameters.policyP2P = policiesP2P[policy];
+            SchedulerCore core;
+            if (!core.configure(parameters)) {
+                std::fprintf(stderr, "unknown policy %s / %s\n", policiesSH[policy], policiesP2P[policy]);
+                return 1;
+            }
+            BenchmarkRandom random(1);
+            double graphTime = 0, timeSH = 0, timeP2P = 0;
+            long transmissionsSH = 0, linksP2P = 0;
+            std::vector<std::vector<int>> nodeSlots;
+            std::vector<P2PLink> links;
+            for (int frame = 0; frame < frames; ++frame) {
+                auto start = std::chrono::steady_clock::now();
+                core.buildGraph(scenario.nodeIds, scenario.positions);
+                graphTime += elapsedMicroseconds(start);
+
+                start = std::chrono::steady_clock::now();
+                SchedulingSnapshotSH snapshotSH = core.createSnapshotSH(scenario.bufferStatusSH, scenario.lastAssigned, 0);
+                core.assignSlotsSH(snapshotSH, random, nodeSlots);
+                timeSH += elapsedMicroseconds(start);
+                for (const std::vector<int>& slots : nodeSlots) {
+                    transmissionsSH += slots.size();
+                }
+
+                // One P2P pass per slot of the frame
+                start = std::chrono::steady_clock::now();
+                for (int slot = 0; slot < parameters.frameSlots; ++slot) {
+                    SchedulingSnapshotP2P snapshotP2P = core.createSnapshotP2P(scenario.bufferStatusP2P, scenario.destinationsP2P,
+                            scenario.lastAssigned, scenario.busy, slot * parameters.slotDuration);
+                    core.assignLinksP2P(snapshotP2P, random, links);
+                    linksP2P += links.size();
+                }
+                timeP2P += elapsedMicroseconds(start);
+            }
+            std::printf("%6d  %-16s  %-16s  %12.1f  %12.1f  %12.1f  %10.1f  %10.1f\n", numNodes, policiesSH[policy], policiesP2P[policy],
+                    graphTime / frames, timeSH / frames, timeP2P / frames, (double)transmissionsSH / frames, (double)linksP2P / frames);
+        }
+    }
+
+    // The speedup is bounded by the hardware threads of the machine
+    std::printf("\nGraph build with %u hardware threads\n", std::thread::hardware_concurrency());
+    std::printf("%6s  %8s  %12s  %8s\n", "nodes", "threads", "graph [us]", "speedup");
+    for (int numNodes : {1000, 5000, 10000}) {
+        Scenario scenario(numNodes, range, 10, 1);
+        double serialTime = 0;
+        for (int numThreads : {1, 2, 4, 8}) {
+            SchedulerCoreParameters parameters;
+            parameters.communicationRange = range;
+            parameters.graphBuildThreads = numThreads;
+            SchedulerCore core;
+            core.configure(parameters);
+            double graphTime = 0;
+            for (int frame = 0; frame < frames; ++frame) {
+                auto start = std::chrono::steady_clock::now();
+                core.buildGraph(scenario.nodeIds, scenario.positions);
+                graphTime += elapsedMicroseconds(start);
+            }
+            if (numThreads == 1) {
+                serialTime = graphTime;
+            }
+            std::printf("%6d  %8d  %12.1f  %8.2f\n", numNodes, numThreads, graphTime / frames, serialTime / graphTime);
+        }
+    }
+
+    std::printf("\nNeighbour discovery, spatial grid against all pairs\n");
+    std::printf("%6s  %10s  %12s  %14s  %8s\n", "nodes", "edges", "grid [us]", "all pairs [us]", "speedup");
+    for (int numNodes : {100, 1000, 10000}) {
+        Scenario scenario(numNodes, range, 10, 1);
+        SpatialGrid grid(range);
+        std::vector<std::pair<int, int>> gridPairs, bruteForcePairs;
+        double gridTime = 0, bruteForceTime = 0;
+        for (int frame = 0; frame < frames; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+            grid.build(scenario.positions);
+            gridPairs.clear();
+            grid.collectPairsWithinRange(scenario.positions, range, 1, gridPairs);
+            gridTime += elapsedMicroseconds(start);
+
+            start = std::chrono::steady_clock::now();
+            collectPairsBruteForce(scenario.positions, range, bruteForcePairs);
+            bruteForceTime += elapsedMicroseconds(start);
+        }
+        // The grid has to find exactly the edges of the all-pairs test
+        std::sort(gridPairs.begin(), gridPairs.end());
+        if (gridPairs != bruteForcePairs) {
+            std::fprintf(stderr, "spatial grid and all-pairs edge sets differ at %d nodes\n", numNodes);
+            return 1;
+        }
+        std::printf("%6d  %10zu  %12.1f  %14.1f  %8.1f\n", numNodes, gridPairs.size(), gridTime / frames, bruteForceTime / frames, bruteForceTime / gridTime);
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#!/bin/sh
+# The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+# Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Runs every run of the given configuration of omnetpp.ini one after another and appends
+# config, run, N, events, simulated seconds, wall seconds, events/sec, wall seconds per simulated second
+# and peak RSS in KiB to results/scaling.csv. The peak RSS needs GNU time, without it the wall time is taken
+# from the Cmdenv status line and the peak RSS is left empty.
+#
+# Usage: benchmark.sh <config> [further opp_run arguments]
+
+cd `dirname $0`
+CONFIG=${1:-Scaling}
+shift
+SIM=${SIM:-../../src/ldacs_abstract_tdma}
+NEDPATH=${NEDPATH:-.:../../src:../../../inet4/src:../../../ldacs_abstract_radio/src}
+RESULT=results/scaling.csv
+TIME="/usr/bin/time -v"
+if ! /usr/bin/time -v true > /dev/null 2>&1; then
+    echo "GNU time not found, peak RSS will not be recorded" >&2
+    TIME=
+fi
+mkdir -p results
+if [ ! -f $RESULT ]; then
+    echo "config,run,N,events,simsec,wallsec,eventsPerSec,wallPerSimsec,peakRssKiB" > $RESULT
+fi
+
+for RUN in `$SIM -u Cmdenv -n $NEDPATH -c $CONFIG -s -q runnumbers "$@"`; do
+    LOG=results/$CONFIG-$RUN.log
+    $TIME $SIM -u Cmdenv -n $NEDPATH -c $CONFIG -r $RUN "$@" > $LOG 2>&1
+    # Cmdenv prints the iteration variables ("Scenario: $N=100, ...") and the last event ("... at t=60s, event #123"),
+    # GNU time the wall clock time (h:mm:ss or m:ss.ss) and the maximum resident set size; without GNU time
+    # the last Cmdenv status line ("... Elapsed: 12.345s ...") gives the wall time
+    awk -v config=$CONFIG -v run=$RUN '
+        /Scenario:/ { if (match($0, /\$N=[0-9]+/)) n = substr($0, RSTART + 3, RLENGTH - 3) }
+        /event #[0-9]+/ { if (match($0, /event #[0-9]+/)) events = substr($0, RSTART + 7, RLENGTH - 7)
+                          if (match($0, /t=[0-9.e+-]+/)) simsec = substr($0, RSTART + 2, RLENGTH - 2) }
+        /Elapsed \(wall clock\) time/ { k = split($NF, parts, ":"); wall = 0
+                                        for (i = 1; i <= k; ++i) wall = wall * 60 + parts[i] }
+        /Maximum resident set size/ { rss = $NF }
+        /Elapsed: [0-9.]+s/ { if (match($0, /Elapsed: [0-9.]+/)) cmdenvWall = substr($0, RSTART + 9, RLENGTH - 9) }
+        END {
+            if (wall <= 0) wall = cmdenvWall
+            if (wall <= 0 || simsec <= 0) { print "run " run " of " config " did not finish, see its log" > "/dev/stderr"; exit 1 }
+            printf "%s,%s,%s,%s,%s,%.3f,%.1f,%.4f,%s\n", config, run, n, events, simsec, wall, events / wall, wall / simsec, rss
+        }' $LOG >> $RESULT
+done
@@ -20,10 +20,12 @@
 
 #include "../scheduler/TdmaScheduler.h"
 #include "TdmaMac.h"
+#include "AggregationHeader_m.h"
 #include "inet/common/INETUtils.h"
 #include "inet/common/ModuleAccess.h"
 #include "inet/common/ProtocolGroup.h"
 #include "inet/common/ProtocolTag_m.h"
+#include "inet/common/Simsignals.h"
 #include "inet/common/packet/Packet.h"
 #include "inet/linklayer/acking/AckingMac.h"
 #include "inet/linklayer/acking/AckingMacHeader_m.h"
@@ -36,6 +38,8 @@ using namespace inet::physicallayer;
 
 Define_Module(AbstractLdacsTdmaMac);
 
+static const B subframeHeaderLength = B(2); // chunkLength of AggregationSubframeHeader
+
 AbstractLdacsTdmaMac::AbstractLdacsTdmaMac()
 {
 }
@@ -43,7 +47,8 @@ AbstractLdacsTdmaMac::AbstractLdacsTdmaMac()
 AbstractLdacsTdmaMac::~AbstractLdacsTdmaMac()
 {
     assignedSlotsSH.clear();
-    assignedSlotsP2P.clear();
+    grantsP2P.clear();
+    delete currentTxFrameP2P;
     cancelAndDelete(transmissionSelfMessageSH);
     cancelAndDelete(transmissionSelfMessageP2P);
     cancelAndDelete(ackTimeoutMsg);
@@ -68,6 +73,11 @@ void AbstractLdacsTdmaMac::initialize(int stage)
         ackTimeout = par("ackTimeout");
         numRetries = par("numRetries");
         maxP2PLinks = par("maxP2PLinks");
+        aggregation = par("aggregation");
+        slotCapacity = b((int64_t)(bitrate * slotDuration)) - B(headerLength);
+        if (aggregation && slotCapacity <= subframeHeaderLength) {
+            throw cRuntimeError("A slot of %g s at %g bps cannot carry an aggregated frame", slotDuration, bitrate);
+        }
 
         // Retrieve the MAC address of the current node
         IInterfaceTable *interfaceTable = getModuleFromPar<IInterfaceTable>(par("interfaceTableModule"), this);
@@ -103,6 +113,7 @@ void AbstractLdacsTdmaMac::initialize(int stage)
             nodeMacAddress = interfaceEntry->getMacAddress();
             // Obtain nodeId by registering the client and intiating SH and P2P buffers with 0
             nodeId = scheduler->registerClient(this, 0, 0, mobilityModule, nodeMacAddress);
+            pushBufferStatus = !scheduler->pullsBufferStatus();
             if (useAck) {
                 ackTimeoutMsg = new cMessage("link-break");
             }
@@ -116,24 +127,55 @@ void AbstractLdacsTdmaMac::initialize(int stage)
 void AbstractLdacsTdmaMac::handleSelfMessage(cMessage *message)
 {
     if (message == ackTimeoutMsg) {
-        EV << "AckingMac: timeout: " << currentTxFrame->getFullName() << endl;
+        // Only unicast frames are acknowledged, and unicast frames go over P2P
+        Packet *unackedFrame = currentTxFrameP2P != nullptr ? currentTxFrameP2P : currentTxFrame;
+        EV << "AckingMac: timeout: " << unackedFrame->getFullName() << endl;
         if(currentTransmissionAttemps +1 > numRetries) {
             // packet lost
-            emit(linkBrokenSignal, currentTxFrame);
+            emit(linkBrokenSignal, unackedFrame);
             PacketDropDetails details;
             details.setReason(OTHER_PACKET_DROP);
-            dropCurrentTxFrame(details);
+            if (unackedFrame == currentTxFrameP2P) {
+                MacAddress destination = currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress();
+                emit(packetDroppedSignal, currentTxFrameP2P, &details);
+                delete currentTxFrameP2P;
+                currentTxFrameP2P = nullptr;
+                reportBacklogP2P(destination);
+            } else {
+                dropCurrentTxFrame(details);
+            }
             currentTransmissionAttemps = 0;
             EV << "AckingMac: Lost frame" << endl;
         }else {
             EV << "AckingMac: Retrying..." << endl;
             currentTransmissionAttemps++;
+            if (unackedFrame == currentTxFrameP2P) {
+                // The retransmission needs a grant for the destination again
+                reportBacklogP2P(currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress());
+            }
         }
     }
     else if(message == transmissionSelfMessageSH) {
         if (!txQueue->isEmpty()) {
             if(currentTxFrame == nullptr) {
                 popTxQueue();
+                if (aggregation) {
+                    // Fill the slot with the packets queued behind the head packet
+                    vector<Packet *> packets = {currentTxFrame};
+                    b aggregateLength = subframeHeaderLength + currentTxFrame->getDataLength();
+                    while (!txQueue->isEmpty() && canAggregate(currentTxFrame, txQueue->getPacket(0), aggregateLength)) {
+                        Packet *packet = txQueue->popPacket();
+                        take(packet);
+                        aggregateLength += subframeHeaderLength + packet->getDataLength();
+                        packets.push_back(packet);
+                    }
+                    currentTxFrame = createAggregate(packets);
+                }
+                // The frame is the first one of the packing, the later frames stay as they are
+                --slotPackingSH.numSlots;
+                if (txQueue->isEmpty()) {
+                    slotPackingSH = SlotPacking();
+                }
             }
             // Capture start of transmission time
             startTransmissionTimeSH = simTime();
@@ -151,7 +193,24 @@ void AbstractLdacsTdmaMac::handleSelfMessage(cMessage *message)
         }
     }
     else if(message == transmissionSelfMessageP2P) {
-        if (!txQueueP2P->isEmpty()) {
+        // Consume the grant of this slot, it names the virtual queue to serve
+        assignedDestinationP2P = grantsP2P.front().destination;
+        grantsP2P.pop_front();
+        if (ackTimeoutMsg != nullptr && ackTimeoutMsg->isScheduled()) {
+            // The frame of an earlier slot is resent in a later grant if its ACK does not arrive in time
+            EV_INFO << "Waiting for the ACK of " << currentTxFrameP2P->getName() << ", leaving the P2P slot unused" << endl;
+            reportBacklogP2P(assignedDestinationP2P); // The scheduler accounted for a packet sent in the slot
+        }
+        else if (currentTxFrameP2P != nullptr && currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress() != assignedDestinationP2P) {
+            // The unacknowledged frame is only resent in a grant for its own destination
+            EV_INFO << "Retransmission of " << currentTxFrameP2P->getName() << " is pending, leaving the P2P slot to " << assignedDestinationP2P << " unused" << endl;
+            reportBacklogP2P(assignedDestinationP2P);
+        }
+        else if (currentTxFrameP2P == nullptr && virtualQueuesP2P.find(assignedDestinationP2P) == virtualQueuesP2P.end()) {
+            // The scheduler only checked the link to the granted destination, no other destination may use the slot
+            EV_INFO << "Nothing queued for " << assignedDestinationP2P << ", leaving the P2P slot unused" << endl;
+        }
+        else {
             if(currentTxFrameP2P == nullptr) {
                 popTxQueueP2P();
             }
@@ -161,11 +220,11 @@ void AbstractLdacsTdmaMac::handleSelfMessage(cMessage *message)
             emit(macDelayP2PSignal, macLayerDelayP2P);
             scheduler->recordTransmissionTimeP2P(nodeId, startTransmissionTimeP2P);
             startTransmittingP2P();
-            headOfQueueTimeP2P = simTime();
-            if(hasFutureGrantP2P()) {
-                simtime_t nextTransmissionSlotTime = getNextTransmissionSlotP2P();
-                scheduleAt(nextTransmissionSlotTime, transmissionSelfMessageP2P);
-            }
+        }
+        // Later grants of the planning horizon are kept even if the queue ran empty, new packets may use them
+        if(hasFutureGrantP2P()) {
+            simtime_t nextTransmissionSlotTime = getNextTransmissionSlotP2P();
+            scheduleAt(nextTransmissionSlotTime, transmissionSelfMessageP2P);
         }
     }
     else {
@@ -177,19 +236,28 @@ void AbstractLdacsTdmaMac::handleUpperPacket(Packet *packet)
 {
     MacAddress dest = packet->findTag<MacAddressReq>()->getDestAddress();
     if (!dest.isBroadcast() && !dest.isMulticast() && !dest.isUnspecified()) { // unicast use a point-to-point channel
-        if (txQueueP2P->isEmpty()) {
-            headOfQueueTimeP2P = simTime();
-        }
         EV_INFO << "Received an application unicast packet." << endl;
-        txQueueP2P->pushPacket(packet);
-        scheduler->reportBufferStatusP2P(nodeId, txQueueP2P->getNumPackets());
+        pushTxQueueP2P(packet);
+        if (pushBufferStatus) {
+            scheduler->reportBufferStatusP2P(nodeId, getBacklogP2P());
+        }
     }
     else { // use shared channel
         if (txQueue->isEmpty()) {
             headOfQueueTimeSH = simTime();
         }
+        int numPackets = txQueue->getNumPackets();
         txQueue->pushPacket(packet);
-        scheduler->reportBufferStatusSH(nodeId, txQueue->getNumPackets());
+        if (txQueue->getNumPackets() != numPackets + 1) {
+            // The queue dropped a packet, which is not necessarily the new one
+            rebuildSlotPackingSH();
+        }
+        else {
+            addToSlotPacking(slotPackingSH, packet);
+        }
+        if (pushBufferStatus) {
+            scheduler->reportBufferStatusSH(nodeId, getBacklogSH());
+        }
     }
 }
 
@@ -202,6 +270,17 @@ void AbstractLdacsTdmaMac::acked(Packet *frame)
     Enter_Method_Silent();
     ASSERT(useAck);
 
+    if (currentTxFrameP2P != nullptr) {
+        // The frame is kept until the ACK arrives, the next P2P grant then serves a new packet
+        EV_DEBUG << "AckingMac::acked(" << frame->getFullName() << ") is accepted for P2P\n";
+        MacAddress destination = currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress();
+        cancelEvent(ackTimeoutMsg);
+        delete currentTxFrameP2P;
+        currentTxFrameP2P = nullptr;
+        currentTransmissionAttemps = 0;
+        reportBacklogP2P(destination);
+        return;
+    }
     if (currentTxFrame == nullptr) {
         throw cRuntimeError("Unexpected ACK received");
     }
@@ -209,7 +288,9 @@ void AbstractLdacsTdmaMac::acked(Packet *frame)
     EV_DEBUG << "AckingMac::acked(" << frame->getFullName() << ") is accepted\n";
     cancelEvent(ackTimeoutMsg);
     deleteCurrentTxFrame();
-    scheduler->reportBufferStatusSH(nodeId, txQueue->getNumPackets());
+    if (pushBufferStatus) {
+        scheduler->reportBufferStatusSH(nodeId, getBacklogSH());
+    }
     currentTransmissionAttemps = 0;
 }
 
@@ -217,9 +298,95 @@ void AbstractLdacsTdmaMac::popTxQueueP2P() {
     if (currentTxFrameP2P != nullptr)
         throw cRuntimeError("Model error: incomplete transmission exists");
     ASSERT(txQueueP2P != nullptr); // Ensure the txQueueP2P is not null
-    currentTxFrameP2P = txQueueP2P->popPacket();
-    scheduler->reportBufferStatusP2P(nodeId, txQueueP2P->getNumPackets());
-    take(currentTxFrameP2P); // Take ownership of the packet
+    // Serve the destination of the grant
+    auto it = virtualQueuesP2P.find(assignedDestinationP2P);
+    if (it == virtualQueuesP2P.end()) {
+        throw cRuntimeError("Model error: no packet queued for the granted destination %s", assignedDestinationP2P.str().c_str());
+    }
+    MacAddress destination = it->first;
+    VirtualQueueP2P& virtualQueue = it->second;
+    // Without aggregation only the head packet is sent, otherwise the packets behind it as long as they fit
+    vector<Packet *> packets;
+    b aggregateLength = b(0);
+    while (!virtualQueue.packets.empty() && (packets.empty() || (aggregation && canAggregate(packets.front(), virtualQueue.packets.front(), aggregateLength)))) {
+        Packet *packet = virtualQueue.packets.front();
+        virtualQueue.packets.pop_front();
+        txQueueP2P->removePacket(packet);
+        take(packet); // Take ownership of the packet
+        aggregateLength += subframeHeaderLength + packet->getDataLength();
+        packets.push_back(packet);
+    }
+    --virtualQueue.slotPacking.numSlots; // The packets form the first frame of the packing
+    currentTxFrameP2P = aggregation ? createAggregate(packets) : packets.front();
+    headOfQueueTimeP2P = virtualQueue.headOfQueueTime;
+    virtualQueue.headOfQueueTime = simTime(); // The next packet of this destination becomes head now
+    if (virtualQueue.packets.empty()) {
+        virtualQueuesP2P.erase(it);
+    }
+    reportBacklogP2P(destination);
+}
+
+void AbstractLdacsTdmaMac::pushTxQueueP2P(Packet *packet) {
+    MacAddress destination = packet->getTag<MacAddressReq>()->getDestAddress();
+    int numPackets = txQueueP2P->getNumPackets();
+    txQueueP2P->pushPacket(packet);
+    if (txQueueP2P->getNumPackets() != numPackets + 1) {
+        // The queue dropped a packet, which is not necessarily the new one
+        rebuildVirtualQueuesP2P();
+        return;
+    }
+    VirtualQueueP2P& virtualQueue = virtualQueuesP2P[destination];
+    if (virtualQueue.packets.empty()) {
+        virtualQueue.headOfQueueTime = simTime();
+    }
+    virtualQueue.packets.push_back(packet);
+    addToSlotPacking(virtualQueue.slotPacking, packet);
+    reportVirtualQueueP2P(destination);
+}
+
+void AbstractLdacsTdmaMac::rebuildVirtualQueuesP2P() {
+    map<MacAddress, VirtualQueueP2P> previousQueues;
+    previousQueues.swap(virtualQueuesP2P);
+    for (int i = 0; i < txQueueP2P->getNumPackets(); ++i) {
+        Packet *packet = txQueueP2P->getPacket(i);
+        MacAddress destination = packet->getTag<MacAddressReq>()->getDestAddress();
+        VirtualQueueP2P& virtualQueue = virtualQueuesP2P[destination];
+        if (virtualQueue.packets.empty()) {
+            auto previous = previousQueues.find(destination);
+            virtualQueue.headOfQueueTime = previous != previousQueues.end() ? previous->second.headOfQueueTime : simTime();
+        }
+        virtualQueue.packets.push_back(packet);
+        addToSlotPacking(virtualQueue.slotPacking, packet);
+    }
+    for (const auto& entry : previousQueues) {
+        reportVirtualQueueP2P(entry.first);
+    }
+    for (const auto& entry : virtualQueuesP2P) {
+        if (previousQueues.find(entry.first) == previousQueues.end()) {
+            reportVirtualQueueP2P(entry.first);
+        }
+    }
+}
+
+void AbstractLdacsTdmaMac::reportVirtualQueueP2P(const MacAddress& destination) {
+    if (!pushBufferStatus) {
+        return;
+    }
+    auto it = virtualQueuesP2P.find(destination);
+    int backlog = it != virtualQueuesP2P.end() ? it->second.slotPacking.numSlots : 0;
+    scheduler->reportBufferStatusP2P(nodeId, destination, backlog + getPendingBacklogP2P(destination));
+}
+
+void AbstractLdacsTdmaMac::reportBacklogP2P(const MacAddress& destination) {
+    if (pushBufferStatus) {
+        scheduler->reportBufferStatusP2P(nodeId, getBacklogP2P());
+    }
+    reportVirtualQueueP2P(destination);
+}
+
+int AbstractLdacsTdmaMac::getPendingBacklogP2P(const MacAddress& destination) const {
+    // A frame kept for a retransmission needs one more slot to its destination
+    return currentTxFrameP2P != nullptr && currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress() == destination ? 1 : 0;
 }
 
 void AbstractLdacsTdmaMac::startTransmittingP2P() {
@@ -227,11 +394,16 @@ void AbstractLdacsTdmaMac::startTransmittingP2P() {
     MacAddress dest = currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress();
     Packet *msg = currentTxFrameP2P;
     if (useAck && !dest.isBroadcast() && !dest.isMulticast() && !dest.isUnspecified()) {    // unicast
+        if (ackTimeoutMsg->isScheduled()) {
+            throw cRuntimeError("Model error: P2P transmission while an ACK is outstanding");
+        }
         msg = currentTxFrameP2P->dup();
         scheduleAt(simTime() + ackTimeout, ackTimeoutMsg);
     }
-    else
+    else {
         currentTxFrameP2P = nullptr;
+        reportBacklogP2P(dest); // popTxQueueP2P() still counted the frame
+    }
 
     encapsulate(msg);
 
@@ -241,6 +413,87 @@ void AbstractLdacsTdmaMac::startTransmittingP2P() {
     sendDown(msg);
 }
 
+void AbstractLdacsTdmaMac::decapsulate(Packet *frame) {
+    AckingMac::decapsulate(frame);
+    if (!aggregation) {
+        return;
+    }
+    // Every subframe but the last is sent up as a packet of its own, the last one stays in the frame
+    while (true) {
+        auto subframeHeader = frame->popAtFront<AggregationSubframeHeader>();
+        B length = B(subframeHeader->getLength());
+        if (frame->getDataLength() <= length) {
+            break;
+        }
+        Packet *packet = new Packet(frame->getName(), frame->popAtFront(length));
+        // Only the indications of AckingMac::decapsulate() hold for every subframe, the frame's other tags are the first packet's
+        *packet->addTag<MacAddressInd>() = *frame->getTag<MacAddressInd>();
+        *packet->addTag<InterfaceInd>() = *frame->getTag<InterfaceInd>();
+        *packet->addTag<PacketProtocolTag>() = *frame->getTag<PacketProtocolTag>();
+        *packet->addTag<DispatchProtocolReq>() = *frame->getTag<DispatchProtocolReq>();
+        EV_INFO << "Passing up subframe of " << length << " of aggregated frame " << frame->getName() << endl;
+        sendUp(packet);
+    }
+}
+
+bool AbstractLdacsTdmaMac::canAggregate(Packet *head, Packet *packet, b aggregateLength) const {
+    if (aggregateLength + subframeHeaderLength + packet->getDataLength() > slotCapacity) {
+        return false;
+    }
+    // All subframes share the MAC header of the frame
+    return packet->getTag<MacAddressReq>()->getDestAddress() == head->getTag<MacAddressReq>()->getDestAddress()
+            && packet->getTag<PacketProtocolTag>()->getProtocol() == head->getTag<PacketProtocolTag>()->getProtocol();
+}
+
+Packet *AbstractLdacsTdmaMac::createAggregate(const vector<Packet *>& packets) {
+    Packet *frame = new Packet(packets.size() == 1 ? packets.front()->getName() : "Aggregate");
+    frame->copyTags(*packets.front());
+    for (Packet *packet : packets) {
+        auto subframeHeader = makeShared<AggregationSubframeHeader>();
+        subframeHeader->setLength(B(packet->getDataLength()).get());
+        frame->insertAtBack(subframeHeader);
+        frame->insertAtBack(packet->peekData());
+        delete packet;
+    }
+    EV_INFO << "Aggregated " << packets.size() << " packets into " << frame->getName() << endl;
+    return frame;
+}
+
+void AbstractLdacsTdmaMac::addToSlotPacking(SlotPacking& slotPacking, Packet *packet) const {
+    // Same rule as the transmissions: a packet joins the last frame if it fits, otherwise it starts a new one
+    if (aggregation && slotPacking.lastFrameHead != nullptr && canAggregate(slotPacking.lastFrameHead, packet, slotPacking.lastFrameLength)) {
+        slotPacking.lastFrameLength += subframeHeaderLength + packet->getDataLength();
+        return;
+    }
+    ++slotPacking.numSlots;
+    slotPacking.lastFrameHead = packet;
+    slotPacking.lastFrameLength = subframeHeaderLength + packet->getDataLength();
+}
+
+void AbstractLdacsTdmaMac::rebuildSlotPackingSH() {
+    slotPackingSH = SlotPacking();
+    for (int i = 0; i < txQueue->getNumPackets(); ++i) {
+        addToSlotPacking(slotPackingSH, txQueue->getPacket(i));
+    }
+}
+
+b AbstractLdacsTdmaMac::getSlotCapacity() const {
+    return aggregation ? slotCapacity - subframeHeaderLength : slotCapacity;
+}
+
+int AbstractLdacsTdmaMac::getBacklogSH() const {
+    return slotPackingSH.numSlots;
+}
+
+int AbstractLdacsTdmaMac::getBacklogP2P() const {
+    // Only packets to the same destination are aggregated
+    int backlog = 0;
+    for (const auto& entry : virtualQueuesP2P) {
+        backlog += entry.second.slotPacking.numSlots;
+    }
+    return backlog + (currentTxFrameP2P != nullptr ? 1 : 0);
+}
+
 void AbstractLdacsTdmaMac::receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details) {
     EV <<  "AbstractLdacsTdmaMac: Ignoring radio initiated transmission" << endl;
 }
@@ -265,14 +518,9 @@ simtime_t AbstractLdacsTdmaMac::getNextTransmissionSlotSH() {
 }
 
 simtime_t AbstractLdacsTdmaMac::getNextTransmissionSlotP2P() {
-    double currentTime = simTime().dbl();
-    int currentGlobalSlotIndex = ceil(currentTime / slotDuration);
-
-    // Iterate over the assigned slots and see if there is a grant
-    if (assignedSlotP2P != -1) {
-        if (assignedSlotP2P == currentGlobalSlotIndex) {
-            return assignedSlotP2P * slotDuration;
-        }
+    // Grants are kept in slot order, so the earliest one is at the front
+    if (!grantsP2P.empty()) {
+        return grantsP2P.front().slot * slotDuration;
     }
 
     throw cRuntimeError("AbstractLdacsTdmaMac tamara thinks we have a next grant but can't find it");
@@ -293,17 +541,18 @@ simtime_t AbstractLdacsTdmaMac::getFirstSlotInNextFrameSH() {
     return 0;
 }
 
-simtime_t AbstractLdacsTdmaMac::getFirstSlotInNextFrameP2P() {
-    double currentTime = simTime().dbl();
-    int currentGlobalSlotIndex = (int)(currentTime / slotDuration);
+simtime_t AbstractLdacsTdmaMac::getNextSlotInCurrentFrameSH() {
+    simtime_t currentTime = simTime();
+    int currentGlobalSlotIndex = (int)(currentTime.dbl() / slotDuration);
     int currentFrameIndex = currentGlobalSlotIndex / buildGraphIntervalSlots;
-    int nextFrameindex = currentFrameIndex + 1;
 
-    if (!assignedSlotsP2P.empty()) {
-        int firstSlot = assignedSlotsP2P[0]; // Access the first slot assigned
-        return (nextFrameindex * buildGraphIntervalSlots + firstSlot) * slotDuration;
+    for (int slot : assignedSlotsSH) {
+        simtime_t slotStartTime = (currentFrameIndex * buildGraphIntervalSlots + slot) * slotDuration;
+        if (slotStartTime > currentTime) {
+            return slotStartTime;
+        }
     }
-    throw cRuntimeError("AbstractLdacsTdmaMac thinks we have a grant but can't find it");
+    throw cRuntimeError("AbstractLdacsTdmaMac thinks we have a grant in the current frame but can't find it");
     return 0;
 }
 
@@ -315,7 +564,7 @@ bool AbstractLdacsTdmaMac::hasGrantSH() {
 }
 
 bool AbstractLdacsTdmaMac::hasGrantP2P() {
-    if (assignedSlotP2P != -1) {
+    if (!grantsP2P.empty()) {
         return true;
     }
     return false;
@@ -349,19 +598,16 @@ bool AbstractLdacsTdmaMac::hasFutureGrantP2P() {
 
     EV << "CurrentSlotIndex Globally: " << currentGlobalSlotIndex << endl;
 
-    // Iterate over the assigned slots
-    if (assignedSlotP2P != -1) {
-        if (assignedSlotP2P == currentGlobalSlotIndex + 1) {
-            // Found the first slot greater than or equal to startIndex
-            EV << "Next grant in P2P channel at global slot " << assignedSlotP2P << endl;
-            return true;
-        }
+    // Grants of past slots have already been consumed by the transmission handler
+    if (!grantsP2P.empty()) {
+        EV << "Next grant in P2P channel at global slot " << grantsP2P.front().slot << endl;
+        return true;
     }
     EV << "No future grant in P2P channel, will wait until next scheduling" << endl;
     return false;
 }
 
-void AbstractLdacsTdmaMac::setScheduleSH(vector<int> slots) {
+void AbstractLdacsTdmaMac::setScheduleSH(vector<int> slots, bool currentFrame) {
     Enter_Method_Silent();
     assignedSlotsSH = slots;
 
@@ -369,15 +615,26 @@ void AbstractLdacsTdmaMac::setScheduleSH(vector<int> slots) {
         cancelEvent(transmissionSelfMessageSH);
     }
     if(hasGrantSH()) {
-        simtime_t nextTransmissionTime = getFirstSlotInNextFrameSH();
+        // A mid-frame update adds slots to the running frame, a regular schedule starts with the next frame
+        simtime_t nextTransmissionTime = currentFrame ? getNextSlotInCurrentFrameSH() : getFirstSlotInNextFrameSH();
         EV_INFO << hostModule->getFullName() << " next transmission time in the SH channel: " << nextTransmissionTime << "s." << endl;
         scheduleAt(nextTransmissionTime, transmissionSelfMessageSH);
     }
 }
 
-void AbstractLdacsTdmaMac::setScheduleP2P(int slot) {
+void AbstractLdacsTdmaMac::setScheduleP2P(const vector<P2PGrant>& grants) {
     Enter_Method_Silent();
-    assignedSlotP2P = slot;
+    // New grants follow the pending ones, grants of slots that already started are dropped
+    int currentGlobalSlotIndex = (int)round(simTime().dbl() / slotDuration);
+    while (!grantsP2P.empty() && grantsP2P.front().slot < currentGlobalSlotIndex) {
+        grantsP2P.pop_front();
+    }
+    for (const P2PGrant& grant : grants) {
+        if (!grantsP2P.empty() && grant.slot <= grantsP2P.back().slot) {
+            throw cRuntimeError("P2P grant for slot %d does not follow the pending grant for slot %d", grant.slot, grantsP2P.back().slot);
+        }
+        grantsP2P.push_back(grant);
+    }
 
     if(transmissionSelfMessageP2P->isScheduled()) {
         cancelEvent(transmissionSelfMessageP2P);
@@ -413,3 +670,16 @@ bool AbstractLdacsTdmaMac::queueIsEmptyP2P() {
         return true; // Or handle this case as needed
     }
 }
+
+void AbstractLdacsTdmaMac::getVirtualQueueBacklogsP2P(vector<pair<MacAddress, int>>& backlogs) const {
+    backlogs.clear();
+    for (const auto& entry : virtualQueuesP2P) {
+        backlogs.push_back(make_pair(entry.first, entry.second.slotPacking.numSlots + getPendingBacklogP2P(entry.first)));
+    }
+    if (currentTxFrameP2P != nullptr) {
+        MacAddress destination = currentTxFrameP2P->getTag<MacAddressReq>()->getDestAddress();
+        if (virtualQueuesP2P.find(destination) == virtualQueuesP2P.end()) {
+            backlogs.push_back(make_pair(destination, 1));
+        }
+    }
+}
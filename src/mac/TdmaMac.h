@@ -29,12 +29,20 @@
 #include "inet/common/ProtocolTag_m.h"
 #include "inet/common/packet/Packet.h"
 #include "inet/mobility/contract/IMobility.h"
+#include <deque>
+#include <map>
 using namespace inet;
 using namespace std;
 
 
 class AbstractLdacsTdmaScheduler;
 
+/** @brief One P2P slot granted by the scheduler and the destination to be served in it. */
+struct P2PGrant
+{
+    int slot;                                  ///< Global slot index of the grant.
+    MacAddress destination;                    ///< Destination whose virtual queue is served in the slot.
+};
 
 /** @brief
  * Implementation of the MAC layer
@@ -59,10 +67,29 @@ class AbstractLdacsTdmaMac : public AckingMac
         // Transmission queues
         queueing::IPacketQueue *txQueueP2P = nullptr; ///< Queue for P2P unicast messages.
 
+        /** @brief Frames a queue fills when its packets are aggregated head first, as the transmissions do. */
+        struct SlotPacking
+        {
+            int numSlots = 0;                      ///< Number of frames, i.e. slots, of the queued packets.
+            Packet *lastFrameHead = nullptr;       ///< First packet of the last frame, later packets join it while they fit.
+            b lastFrameLength = b(0);              ///< Subframe headers and data of the last frame.
+        };
+        SlotPacking slotPackingSH;                 ///< Packing of txQueue.
+
+        /** @brief Packets of txQueueP2P addressed to one destination, oldest first. */
+        struct VirtualQueueP2P
+        {
+            deque<Packet *> packets;
+            simtime_t headOfQueueTime;             ///< Time the current head packet became head of this queue.
+            SlotPacking slotPacking;               ///< Packing of the queued packets.
+        };
+        map<MacAddress, VirtualQueueP2P> virtualQueuesP2P; ///< Per-destination view of txQueueP2P, empty queues are removed.
+
         // Schedule and slot information
         vector<int> assignedSlotsSH;               ///< Slots assigned for SH communication.
-        vector<int> assignedSlotsP2P;              ///< Slots assigned for P2P communication.
-        int assignedSlotP2P;                       ///< Single slot assigned for P2P communication.
+        deque<P2PGrant> grantsP2P;                 ///< Pending P2P grants, earliest first, one transmission each.
+        MacAddress assignedDestinationP2P;         ///< Destination whose virtual queue is served in the current P2P slot.
+        bool pushBufferStatus = true;              ///< Report every queue change to the scheduler, false if the scheduler pulls queue lengths itself.
 
         // MAC layer identifiers and settings
         int nodeId;                                ///< ID of this MAC layer as obtained by the scheduler.
@@ -71,11 +98,13 @@ class AbstractLdacsTdmaMac : public AckingMac
         int buildGraphIntervalSlots;               ///< Interval (in slots) to rebuild the connectivity graph.
         int numRetries;                            ///< Maximum number of retransmissions.
         int maxP2PLinks;                           ///< Maximum number of usable P2P links.
+        bool aggregation = false;                  ///< Pack as many queued packets as fit into one slot into a single frame.
+        b slotCapacity = b(0);                     ///< Data that fits into one slot next to the MAC header.
 
         // MAC delay measurement
         simtime_t headOfQueueTimeSH;               ///< Timestamp when a packet was enqueued for SH.
         simtime_t startTransmissionTimeSH;         ///< Start time of current transmission in SH.
-        simtime_t headOfQueueTimeP2P;              ///< Timestamp when a packet was enqueued for P2P.
+        simtime_t headOfQueueTimeP2P;              ///< Timestamp when the current P2P frame became head of its virtual queue.
         simtime_t startTransmissionTimeP2P;        ///< Start time of current transmission in P2P.
 
         // Self-messages for handling transmission
@@ -88,22 +117,41 @@ class AbstractLdacsTdmaMac : public AckingMac
         virtual void handleMessageWhenDown(cMessage *message) override;
         virtual void handleSelfMessage(cMessage *message) override;
         virtual void acked(Packet *frame) override; ///< Callback function for another MAC instance to acknowledge a frame 
+        virtual void decapsulate(Packet *frame) override; ///< Also sends up all but the last packet of an aggregated frame.
 
         // MAC Logic
         void popTxQueueP2P(); 
+        void pushTxQueueP2P(Packet *packet);       ///< Enqueues in txQueueP2P and the destination's virtual queue.
+        void rebuildVirtualQueuesP2P();            ///< Re-indexes txQueueP2P after the queue dropped packets on its own.
+        void reportVirtualQueueP2P(const MacAddress& destination); ///< Reports the backlog of one destination to the scheduler.
+        void reportBacklogP2P(const MacAddress& destination); ///< Reports the total backlog and the backlog of one destination to the scheduler.
+        int getPendingBacklogP2P(const MacAddress& destination) const; ///< Slot still needed by an unacknowledged frame to the destination.
         void startTransmittingP2P(); 
+
+        // Aggregation
+        bool canAggregate(Packet *head, Packet *packet, b aggregateLength) const; ///< Whether packet fits behind aggregateLength of data already collected after head.
+        Packet *createAggregate(const vector<Packet *>& packets); ///< Builds one frame of subframe headers and packet data, deletes the packets.
+        void addToSlotPacking(SlotPacking& slotPacking, Packet *packet) const; ///< Appends a packet behind the queued ones.
+        void rebuildSlotPackingSH();               ///< Packs txQueue anew after the queue dropped packets on its own.
+        int getBacklogSH() const;
+        int getBacklogP2P() const;
         void receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details) override; ///< Overwritten function to prohibit the radio from causing transmissions
         simtime_t getNextTransmissionSlotSH(), getNextTransmissionSlotP2P();
-        simtime_t getFirstSlotInNextFrameSH(), getFirstSlotInNextFrameP2P();
+        simtime_t getFirstSlotInNextFrameSH();
+        simtime_t getNextSlotInCurrentFrameSH();   ///< First assigned SH slot of the running frame that has not started yet.
         bool hasGrantSH(), hasGrantP2P();
         bool hasFutureGrantSH(), hasFutureGrantP2P();
 
     public:
         // Interface Functions
-        void setScheduleSH(vector<int> slots);
-        void setScheduleP2P(int slot);
+        void setScheduleSH(vector<int> slots, bool currentFrame = false); ///< currentFrame marks a mid-frame update of the running frame's grant.
+        void setScheduleP2P(const vector<P2PGrant>& grants); ///< Appends P2P grants, ordered by slot and later than the pending ones.
         MacAddress getHeadOfQueueMacP2P(); ///< This function return the MAC header with the destination address
         bool queueIsEmptyP2P();
+        int getBufferStatusSH() const { return getBacklogSH(); } ///< Backlog in slots pulled by the scheduler.
+        int getBufferStatusP2P() const { return getBacklogP2P(); } ///< Backlog in slots pulled by the scheduler.
+        void getVirtualQueueBacklogsP2P(vector<pair<MacAddress, int>>& backlogs) const; ///< Per-destination backlogs in slots pulled by the scheduler.
+        b getSlotCapacity() const; ///< Largest packet that is sent in a single slot.
     
         // Constructor and destructor
         AbstractLdacsTdmaMac();
@@ -0,0 +1,147 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Rlc.h"
+#include "RlcHeader_m.h"
+#include "inet/common/ModuleAccess.h"
+#include "inet/linklayer/common/MacAddressTag_m.h"
+
+Define_Module(Rlc);
+
+static const B rlcHeaderLength = B(4); // chunkLength of RlcHeader
+
+void Rlc::initialize()
+{
+    upperLayerInGateId = findGate("upperLayerIn");
+    upperLayerOutGateId = findGate("upperLayerOut");
+    lowerLayerInGateId = findGate("lowerLayerIn");
+    lowerLayerOutGateId = findGate("lowerLayerOut");
+    mac = getModuleFromPar<AbstractLdacsTdmaMac>(par("macModule"), this);
+    reassemblyTimeout = par("reassemblyTimeout");
+
+    numSegmentsSignal = registerSignal("numSegments");
+    reassemblyFailedSignal = registerSignal("reassemblyFailed");
+}
+
+void Rlc::handleMessage(cMessage *message)
+{
+    if (message->getArrivalGateId() == upperLayerInGateId) {
+        handleUpperPacket(check_and_cast<Packet *>(message));
+    }
+    else if (message->getArrivalGateId() == lowerLayerInGateId) {
+        handleLowerPacket(check_and_cast<Packet *>(message));
+    }
+    else {
+        throw cRuntimeError("Rlc received message %s on an unknown gate", message->getName());
+    }
+}
+
+void Rlc::handleUpperPacket(Packet *sdu)
+{
+    // The slot capacity is read per SDU as it depends on the MAC's aggregation setting
+    B maxSegmentLength = B(mac->getSlotCapacity()) - rlcHeaderLength;
+    if (maxSegmentLength <= B(0)) {
+        throw cRuntimeError("A slot of the MAC cannot carry an RLC segment");
+    }
+    B sduLength = B(sdu->getDataLength());
+    if (sduLength > B(UINT16_MAX)) {
+        throw cRuntimeError("SDU %s exceeds the segment offset range of the RLC header", sdu->getName());
+    }
+    uint16_t sequenceNumber = nextSequenceNumber++;
+    int numSegments = 0;
+    for (B offset = B(0); offset < sduLength; offset = offset + maxSegmentLength) {
+        B segmentLength = std::min(maxSegmentLength, sduLength - offset);
+        auto header = makeShared<RlcHeader>();
+        header->setSequenceNumber(sequenceNumber);
+        header->setSegmentOffset(offset.get());
+        header->setLastSegment(offset + segmentLength == sduLength);
+        // peekDataAt returns a slice that shares the data of the SDU
+        Packet *segment = new Packet(sdu->getName(), sdu->peekDataAt(offset, segmentLength));
+        segment->insertAtFront(header);
+        segment->copyTags(*sdu);
+        send(segment, lowerLayerOutGateId);
+        numSegments++;
+    }
+    EV_INFO << "Sent SDU " << sdu->getName() << " (" << sduLength << ") in " << numSegments << " segments" << endl;
+    emit(numSegmentsSignal, (long)numSegments);
+    delete sdu;
+}
+
+void Rlc::handleLowerPacket(Packet *segment)
+{
+    discardStaleReassemblyBuffers();
+    auto header = segment->popAtFront<RlcHeader>();
+    if (header->getSegmentOffset() == 0 && header->getLastSegment()) {
+        // The SDU fit into a single segment
+        send(segment, upperLayerOutGateId);
+        return;
+    }
+    MacAddress source = segment->getTag<MacAddressInd>()->getSrcAddress();
+    auto key = make_pair(source, header->getSequenceNumber());
+    ReassemblyBuffer& buffer = reassemblyBuffers[key];
+    if (buffer.segments.empty()) {
+        buffer.creationTime = simTime();
+    }
+    B offset = B(header->getSegmentOffset());
+    buffer.segments[offset] = segment->peekData();
+    if (header->getLastSegment()) {
+        buffer.length = offset + B(segment->getDataLength());
+    }
+    if (!isComplete(buffer)) {
+        delete segment;
+        return;
+    }
+    // Adjacent slices of the same chunk are merged again, so the SDU is not copied either
+    Packet *sdu = new Packet(segment->getName());
+    for (const auto& entry : buffer.segments) {
+        sdu->insertAtBack(entry.second);
+    }
+    sdu->copyTags(*segment);
+    EV_INFO << "Reassembled SDU " << sdu->getName() << " from " << buffer.segments.size() << " segments of " << source << endl;
+    reassemblyBuffers.erase(key);
+    delete segment;
+    send(sdu, upperLayerOutGateId);
+}
+
+bool Rlc::isComplete(const ReassemblyBuffer& buffer) const
+{
+    if (buffer.length < B(0)) {
+        return false;
+    }
+    B expectedOffset = B(0);
+    for (const auto& entry : buffer.segments) {
+        if (entry.first != expectedOffset) {
+            return false;
+        }
+        expectedOffset = expectedOffset + B(entry.second->getChunkLength());
+    }
+    return expectedOffset == buffer.length;
+}
+
+void Rlc::discardStaleReassemblyBuffers()
+{
+    simtime_t now = simTime();
+    for (auto it = reassemblyBuffers.begin(); it != reassemblyBuffers.end();) {
+        if (it->second.creationTime + reassemblyTimeout < now) {
+            EV_WARN << "Discarding incomplete SDU " << it->first.second << " of " << it->first.first << endl;
+            emit(reassemblyFailedSignal, (long)it->second.segments.size());
+            it = reassemblyBuffers.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
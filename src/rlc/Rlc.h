@@ -0,0 +1,66 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_RLC_H
+#define __INET_RLC_H
+
+#include "../mac/TdmaMac.h"
+#include "inet/common/INETDefs.h"
+#include "inet/common/packet/Packet.h"
+#include "inet/linklayer/common/MacAddress.h"
+#include <map>
+
+using namespace inet;
+using namespace std;
+
+/** @brief
+ * Radio link control between the network layer and the MAC. Every SDU is sent
+ * in segments that fit into a single slot of the MAC, the receiver reassembles
+ * the SDU once all of its segments arrived.
+ */
+class Rlc : public cSimpleModule
+{
+    protected:
+        /** @brief Segments of one SDU received so far. */
+        struct ReassemblyBuffer
+        {
+            map<B, Ptr<const Chunk>> segments;   ///< Segment data by offset within the SDU.
+            B length = B(-1);                    ///< SDU length, known once the last segment arrived.
+            simtime_t creationTime;              ///< Arrival time of the first segment.
+        };
+
+        // Simulation signals
+        simsignal_t numSegmentsSignal;
+        simsignal_t reassemblyFailedSignal;
+
+        int upperLayerInGateId = -1;
+        int upperLayerOutGateId = -1;
+        int lowerLayerInGateId = -1;
+        int lowerLayerOutGateId = -1;
+        AbstractLdacsTdmaMac *mac = nullptr;     ///< MAC that determines the slot capacity.
+        simtime_t reassemblyTimeout;             ///< Time after which an incomplete SDU is discarded.
+        uint16_t nextSequenceNumber = 0;         ///< Sequence number of the next SDU sent.
+        map<pair<MacAddress, uint16_t>, ReassemblyBuffer> reassemblyBuffers; ///< Incomplete SDUs by source and sequence number.
+
+        void initialize() override;
+        void handleMessage(cMessage *message) override;
+        void handleUpperPacket(Packet *sdu);     ///< Segments the SDU and sends the segments to the MAC.
+        void handleLowerPacket(Packet *segment); ///< Reassembles and sends up the SDU once it is complete.
+        bool isComplete(const ReassemblyBuffer& buffer) const;
+        void discardStaleReassemblyBuffers();
+};
+
+#endif // __INET_RLC_H
@@ -0,0 +1,122 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_NODE_TABLE_H
+#define __INET_NODE_TABLE_H
+
+#include "inet/common/INETDefs.h"
+#include "inet/linklayer/common/MacAddress.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "core/SchedulingPolicy.h"
+#include <unordered_map>
+#include <vector>
+
+using namespace inet;
+
+class AbstractLdacsTdmaMac;
+
+/** @brief Hash functor so that MAC addresses can key unordered containers. */
+struct MacAddressHash
+{
+    size_t operator()(const MacAddress& address) const { return std::hash<uint64_t>()(address.getInt()); }
+};
+
+/** @brief Dense, node ID indexed structure-of-arrays holding the scheduler's per-node state.
+ *
+ * Node IDs are handed out consecutively by the scheduler, so every column is a
+ * plain vector and a node's state is found by indexing instead of a tree lookup.
+ */
+struct NodeTable
+{
+    // Marks a node that was never assigned in lastAssignedSH / lastAssignedP2P
+    static constexpr double NEVER_ASSIGNED = -1;
+
+    std::vector<AbstractLdacsTdmaMac*> clients;
+    std::vector<MacAddress> macAddresses;
+    std::vector<IMobility*> mobilityModules;
+    std::vector<int> bufferStatusSH;
+    std::vector<int> bufferStatusP2P;
+    std::vector<std::vector<P2PDemand>> destinationsP2P; // P2P backlog per recipient node ID in round-robin order
+    std::vector<double> lastAssignedSH; // Last assignment time in SH, seconds
+    std::vector<double> lastAssignedP2P; // Last assignment time in P2P, seconds
+    std::unordered_map<MacAddress, int, MacAddressHash> nodeIdByMac;
+
+    int size() const { return (int)clients.size(); }
+    bool contains(int nodeId) const { return nodeId >= 0 && nodeId < size(); }
+
+    int addNode(AbstractLdacsTdmaMac *mac, const MacAddress& macAddress, IMobility *mobilityModule, int statusSH, int statusP2P) {
+        int nodeId = size();
+        clients.push_back(mac);
+        macAddresses.push_back(macAddress);
+        mobilityModules.push_back(mobilityModule);
+        bufferStatusSH.push_back(statusSH);
+        bufferStatusP2P.push_back(statusP2P);
+        destinationsP2P.push_back(std::vector<P2PDemand>());
+        lastAssignedSH.push_back(NEVER_ASSIGNED);
+        lastAssignedP2P.push_back(NEVER_ASSIGNED);
+        nodeIdByMac[macAddress] = nodeId;
+        return nodeId;
+    }
+
+    // Updates the backlog a node reported for one recipient, new recipients join at the back
+    void setDestinationBacklogP2P(int nodeId, int recipientId, int packets) {
+        std::vector<P2PDemand>& destinations = destinationsP2P[nodeId];
+        for (auto it = destinations.begin(); it != destinations.end(); ++it) {
+            if (it->recipient == recipientId) {
+                if (packets > 0) {
+                    it->backlog = packets;
+                } else {
+                    destinations.erase(it);
+                }
+                return;
+            }
+        }
+        if (packets > 0) {
+            destinations.push_back(P2PDemand{recipientId, packets});
+        }
+    }
+
+    int getDestinationBacklogP2P(int nodeId, int recipientId) const {
+        for (const P2PDemand& demand : destinationsP2P[nodeId]) {
+            if (demand.recipient == recipientId) {
+                return demand.backlog;
+            }
+        }
+        return 0;
+    }
+
+    // Accounts for one scheduled packet to the recipient and moves the recipient to the back of the round-robin order
+    void serveDestinationP2P(int nodeId, int recipientId) {
+        std::vector<P2PDemand>& destinations = destinationsP2P[nodeId];
+        for (auto it = destinations.begin(); it != destinations.end(); ++it) {
+            if (it->recipient == recipientId) {
+                P2PDemand served{recipientId, it->backlog - 1};
+                destinations.erase(it);
+                if (served.backlog > 0) {
+                    destinations.push_back(served);
+                }
+                return;
+            }
+        }
+    }
+
+    int findNodeIdByMac(const MacAddress& macAddress) const {
+        auto it = nodeIdByMac.find(macAddress);
+        return it != nodeIdByMac.end() ? it->second : -1;
+    }
+};
+
+#endif
@@ -26,7 +26,10 @@ AbstractLdacsTdmaScheduler::~AbstractLdacsTdmaScheduler() {
     cancelAndDelete(schedulingSHSelfMessage);
     cancelAndDelete(schedulingP2PSelfMessage);
     cancelAndDelete(slotSelfMessage);
-
+    cancelAndDelete(replayGrantSHSelfMessage);
+    for (cHistogram *histogram : phaseHistograms) {
+        delete histogram;
+    }
 }
 
 void AbstractLdacsTdmaScheduler::initialize(int stage) {
@@ -37,6 +40,60 @@ void AbstractLdacsTdmaScheduler::initialize(int stage) {
     minReassignmentSlotsSH = par("minReassignmentSlotsSH");
     minReassignmentSlotsP2P = par("minReassignmentSlotsP2P");
     maxP2PLinks = par("maxP2PLinks");
+    incrementalGrantsSH = par("incrementalGrantsSH");
+    pullBufferStatus = par("bufferStatusReporting").stdstringValue() == "pull";
+    if (pullBufferStatus && incrementalGrantsSH) {
+        throw cRuntimeError("incrementalGrantsSH needs push buffer status reporting to notice newly backlogged nodes.");
+    }
+    p2pPlanningHorizonSlots = par("p2pPlanningHorizonSlots");
+    if (p2pPlanningHorizonSlots < 1) {
+        throw cRuntimeError("The p2pPlanningHorizonSlots parameter should be at least 1.");
+    }
+    reservationsP2P.configure(par("p2pReservationActivationGrants"), (int)par("p2pReservationFrames") * buildGraphIntervalSlots,
+            par("p2pReservationIdleTimeout"), buildGraphIntervalSlots);
+    SchedulerCoreParameters coreParameters;
+    coreParameters.communicationRange = communicationRange;
+    coreParameters.frameSlots = buildGraphIntervalSlots;
+    coreParameters.slotDuration = slotDuration;
+    coreParameters.minReassignmentSlotsSH = minReassignmentSlotsSH;
+    coreParameters.minReassignmentSlotsP2P = minReassignmentSlotsP2P;
+    coreParameters.maxP2PLinks = maxP2PLinks;
+    coreParameters.incrementalGraph = par("incrementalGraph");
+    coreParameters.graphUpdateSlack = par("graphUpdateSlack").doubleValue();
+    coreParameters.graphBuildThreads = resolveNumThreads(par("graphBuildThreads"));
+    coreParameters.policySH = par("schedulingPolicySH").stdstringValue();
+    coreParameters.policyP2P = par("schedulingPolicyP2P").stdstringValue();
+    coreParameters.policyParameters.fairnessWindowSlots = par("fairnessWindowSlots");
+    if (!core.configure(coreParameters)) {
+        throw cRuntimeError("Unknown schedulingPolicySH '%s' or schedulingPolicyP2P '%s'.", par("schedulingPolicySH").stringValue(), par("schedulingPolicyP2P").stringValue());
+    }
+    std::string scheduleTraceFile = par("scheduleTraceFile").stdstringValue();
+    if (!scheduleTraceFile.empty() && !scheduleTrace.open(scheduleTraceFile)) {
+        throw cRuntimeError("Cannot open schedule trace file '%s'.", scheduleTraceFile.c_str());
+    }
+    std::string scheduleReplayFile = par("scheduleReplayFile").stdstringValue();
+    replaySchedule = !scheduleReplayFile.empty();
+    if (replaySchedule) {
+        if (!scheduleTraceFile.empty()) {
+            throw cRuntimeError("scheduleTraceFile and scheduleReplayFile cannot be used together.");
+        }
+        if (!scheduleReplay.open(scheduleReplayFile)) {
+            throw cRuntimeError("Cannot replay schedule trace '%s': %s.", scheduleReplayFile.c_str(), scheduleReplay.getError().c_str());
+        }
+    }
+    phaseTimers.configure({"buildGraph", "assignSlotsSH", "assignIncrementalSlotsSH", "assignSlotsP2P", "notifyMac", "logging"}, this);
+    for (int phase = 0; phase < phaseTimers.getNumPhases(); ++phase) {
+        phaseHistograms.push_back(new cHistogram((phaseTimers.getName(phase) + "WallTime").c_str()));
+    }
+    std::string phaseTimelineFile = par("phaseTimelineFile").stdstringValue();
+    if (!phaseTimelineFile.empty()) {
+        if (!PhaseTimers::COMPILED_IN) {
+            throw cRuntimeError("phaseTimelineFile needs a build with -DLDACS_PHASE_TIMERS (make PHASE_TIMERS=1 build-release).");
+        }
+        if (!phaseTimers.openTimeline(phaseTimelineFile)) {
+            throw cRuntimeError("Cannot open phase timeline file '%s'.", phaseTimelineFile.c_str());
+        }
+    }
     frameDuration = slotDuration * frameLength;
     buildGraphDuration = slotDuration * buildGraphIntervalSlots;
     minReassignmentDurationSH = slotDuration * minReassignmentSlotsSH;
@@ -44,6 +101,16 @@ void AbstractLdacsTdmaScheduler::initialize(int stage) {
 
     scheduleSignal = registerSignal("schedule");
     utilizationSignal = registerSignal("utilization");
+    utilizationP2PSignal = registerSignal("utilizationP2P");
+    linkUtilizationP2PSignal = registerSignal("linkUtilizationP2P");
+    spatialReuseSHSignal = registerSignal("spatialReuseSH");
+    spatialReuseP2PSignal = registerSignal("spatialReuseP2P");
+    servedSHSignal = registerSignal("servedSH");
+    servedP2PSignal = registerSignal("servedP2P");
+    backlogSHSignal = registerSignal("backlogSH");
+    backlogP2PSignal = registerSignal("backlogP2P");
+    unassignedBacklogSHSignal = registerSignal("unassignedBacklogSH");
+    unassignedBacklogP2PSignal = registerSignal("unassignedBacklogP2P");
     ///////////////////////////////////
     /// (record link access delay)
     nodeIdSignal = registerSignal("nodeId"); // Register the signal
@@ -56,12 +123,19 @@ void AbstractLdacsTdmaScheduler::initialize(int stage) {
     slotSelfMessage = new cMessage("slot");
     // Message triggers the building or updating of the network graph for scheduling decisions.
     buildGraphMsg = new cMessage("BuildGraph");
+    // Message replays a mid-frame SH grant of the trace.
+    replayGrantSHSelfMessage = new cMessage("replayGrantSH");
+    // A recorded grant precedes a scheduling pass at the same time, as it did when it was recorded
+    replayGrantSHSelfMessage->setSchedulingPriority(-1);
 
     WATCH(utilization);
 
     // start first scheduling during simulation start
     if (buildGraphIntervalSlots == 0) {
         throw cRuntimeError("The buildGraphIntervalSlots parameter should be larger than 0.");
+    } else if (replaySchedule) {
+        // The graph is only needed to compute schedules, a replay reads them
+        advanceReplay();
     } else {
         scheduleAt(buildGraphDuration - 0.5 * slotDuration, buildGraphMsg);
     }
@@ -79,15 +153,27 @@ void AbstractLdacsTdmaScheduler::handleMessage(cMessage *message) {
     if(message == schedulingSHSelfMessage) {
 
         EV << "AbstractLdacsTdmaScheduler: Start scheduling SH trasnmission" << endl;
-        createScheduleSH();
+        if (replaySchedule) {
+            replayFrameSH();
+        } else {
+            createScheduleSH();
+        }
         // createScheduleP2P();
         // createSchedule();
         scheduleAt(simTime() + buildGraphDuration, schedulingSHSelfMessage);
     }
     else if (message == schedulingP2PSelfMessage) {
         EV << "AbstractLdacsTdmaScheduler: Start scheduling P2P trasnmission" << endl;
-        createScheduleP2P();
-        scheduleAt(simTime() + slotDuration, schedulingP2PSelfMessage);
+        if (replaySchedule) {
+            replayPassP2P();
+        } else {
+            createScheduleP2P();
+        }
+        // The next pass plans the first slot after the current horizon
+        scheduleAt(simTime() + plannedSlotsP2P * slotDuration, schedulingP2PSelfMessage);
+    }
+    else if (message == replayGrantSHSelfMessage) {
+        replayGrantSH();
     }
     else if (message == buildGraphMsg) {
         buildGraph(); // Call your method to build or update the graph
@@ -102,17 +188,26 @@ void AbstractLdacsTdmaScheduler::handleMessage(cMessage *message) {
     } 
 }
 
+void AbstractLdacsTdmaScheduler::finish() {
+    emitMetricsSH();
+    scheduleTrace.close();
+    phaseTimers.closeTimeline();
+    if (PhaseTimers::COMPILED_IN) {
+        for (int phase = 0; phase < phaseTimers.getNumPhases(); ++phase) {
+            const std::string& name = phaseTimers.getName(phase);
+            recordScalar((name + "Calls").c_str(), phaseTimers.getCount(phase));
+            recordScalar((name + "WallTimeTotal").c_str(), phaseTimers.getTotal(phase), "s");
+            recordScalar((name + "WallTimeMax").c_str(), phaseTimers.getMax(phase), "s");
+            recordStatistic(phaseHistograms[phase], "s");
+        }
+    }
+}
+
 int AbstractLdacsTdmaScheduler::registerClient(AbstractLdacsTdmaMac *mac, int statusSH, int statusP2P, inet::IMobility *mobilityModule, MacAddress macAddress) {
     Enter_Method_Silent();
-    int nodeId = numNodes++;
-
-    bufferStatusSH.insert(make_pair(nodeId, statusSH));
-    bufferStatusP2P.insert(make_pair(nodeId, statusP2P));
-    clients.insert(make_pair(nodeId, mac));
-    clientsMacAddress.insert(make_pair(nodeId, macAddress));
-
-    // store mobility modules associated with node IDs
-    mobilityModules.insert(make_pair(nodeId, mobilityModule));
+    // store MAC, mobility module and initial buffer status in the next dense node table row
+    int nodeId = nodes.addNode(mac, macAddress, mobilityModule, statusSH, statusP2P);
+    numNodes = nodes.size();
 
     EV << "SH channel: Registered " << mac->getName() << " as Node #" << nodeId << " with buffer status: " << statusSH << endl;
     EV << "P2P channel: Registered " << mac->getName() << " as Node #" << nodeId << " with buffer status: " << statusP2P << endl;
@@ -122,19 +217,62 @@ int AbstractLdacsTdmaScheduler::registerClient(AbstractLdacsTdmaMac *mac, int st
 void AbstractLdacsTdmaScheduler::reportBufferStatusSH(int nodeId, int bufferStatus) {
     Enter_Method_Silent();
     EV << "SH channel: " << getHostName(nodeId) << " reported a Buffer Status of " << bufferStatus << endl;
-    bufferStatusSH[nodeId] = bufferStatus;
+    int previousBufferStatus = nodes.bufferStatusSH[nodeId];
+    nodes.bufferStatusSH[nodeId] = bufferStatus;
+    if (incrementalGrantsSH && !replaySchedule && previousBufferStatus == 0 && bufferStatus > 0) {
+        assignIncrementalSlotsSH(nodeId);
+    }
 }
 
 void AbstractLdacsTdmaScheduler::reportBufferStatusP2P(int nodeId, int bufferStatus) {
     Enter_Method_Silent();
     EV << "P2P channel: " << getHostName(nodeId) << " reported a buffer status of " << bufferStatus << endl;
-    bufferStatusP2P[nodeId] = bufferStatus;
+    nodes.bufferStatusP2P[nodeId] = bufferStatus;
+}
+
+void AbstractLdacsTdmaScheduler::reportBufferStatusP2P(int nodeId, const MacAddress& destination, int bufferStatus) {
+    Enter_Method_Silent();
+    int recipientId = findNodeIdByMac(destination);
+    if (recipientId == -1) {
+        EV_WARN << "P2P channel: " << getHostName(nodeId) << " reported packets for unknown destination " << destination << endl;
+        return;
+    }
+    EV << "P2P channel: " << getHostName(nodeId) << " reported a buffer status of " << bufferStatus << " for " << getHostName(recipientId) << endl;
+    nodes.setDestinationBacklogP2P(nodeId, recipientId, bufferStatus);
+}
+
+void AbstractLdacsTdmaScheduler::pullBufferStatusSH() {
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        nodes.bufferStatusSH[nodeId] = nodes.clients[nodeId]->getBufferStatusSH();
+    }
+}
+
+void AbstractLdacsTdmaScheduler::pullBufferStatusP2P() {
+    std::vector<std::pair<MacAddress, int>> backlogs;
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        AbstractLdacsTdmaMac *client = nodes.clients[nodeId];
+        nodes.bufferStatusP2P[nodeId] = client->getBufferStatusP2P();
+        // Known destinations keep their round-robin position, drained ones are dropped and new ones join at the back
+        std::vector<P2PDemand>& destinations = nodes.destinationsP2P[nodeId];
+        for (P2PDemand& demand : destinations) {
+            demand.backlog = 0;
+        }
+        client->getVirtualQueueBacklogsP2P(backlogs);
+        for (const auto& backlog : backlogs) {
+            int recipientId = findNodeIdByMac(backlog.first);
+            if (recipientId != -1) {
+                nodes.setDestinationBacklogP2P(nodeId, recipientId, backlog.second);
+            }
+        }
+        destinations.erase(std::remove_if(destinations.begin(), destinations.end(),
+                [](const P2PDemand& demand) { return demand.backlog <= 0; }), destinations.end());
+    }
 }
 
 void AbstractLdacsTdmaScheduler::recordTransmissionTimeSH(int nodeId, simtime_t transmissionTimeSH) {
     Enter_Method_Silent(); 
     // Record the current transmission time for the given node ID
-    lastAssignedSH[nodeId] = transmissionTimeSH;
+    nodes.lastAssignedSH[nodeId] = transmissionTimeSH.dbl();
 
     // EV << "Recorded transmission time in SH channel for " << getHostName(nodeId) << ": " << transmissionTimeSH << endl;
 }
@@ -142,12 +280,13 @@ void AbstractLdacsTdmaScheduler::recordTransmissionTimeSH(int nodeId, simtime_t
 void AbstractLdacsTdmaScheduler::recordTransmissionTimeP2P(int nodeId, simtime_t transmissionTimeP2P) {
     Enter_Method_Silent(); 
     // Record the current transmission time for the given node ID
-    lastAssignedP2P[nodeId] = transmissionTimeP2P;
+    nodes.lastAssignedP2P[nodeId] = transmissionTimeP2P.dbl();
 
     // EV << "Recorded transmission time in P2P channel for " << getHostName(nodeId) << ": " << transmissionTimeP2P << endl;
 }
 
 void AbstractLdacsTdmaScheduler::assignSlotsSH() {
+    PHASE_TIMER(phaseTimers, PHASE_ASSIGN_SH, simTime().dbl());
     // Slot and frame timing information
     initializeSHAssignment();
     updateSlotTimeInfo();
@@ -156,40 +295,127 @@ void AbstractLdacsTdmaScheduler::assignSlotsSH() {
         localToGlobalSlotMappingSH[localSlot] = nextFrameStartGlobalSlotIndex + localSlot;
     }
 
-    // Iterate through each slot
-    for (int slot = 0; slot < buildGraphIntervalSlots; ++slot) {
-        // Calculate the start time for this specific slot in the next frame
-        double slotStartTime = nextFrameStartTime + (slot * slotDuration);
-        std::unordered_set<int> availableNodes = populateAvailableNodesSH(slotStartTime);
-
-        while (!availableNodes.empty()) {
-            int selectedNodeId = selectRandomNode(availableNodes);
-            // Assign the selected node to this slot
-            nodeToSlotsMapSH[selectedNodeId].push_back(slot);
-            // Decrement the buffer status for P2P
-            if (--bufferStatusSH[selectedNodeId] <= 0) {
-                // If the buffer is now empty, remove the node from the bufferStatusSH for this frame
-                bufferStatusSH.erase(selectedNodeId);
-            }
-            availableNodes.erase(selectedNodeId); // Remove the selected node from available nodes
+    emitMetricsSH();
+    metricsSH.begin(buildGraphIntervalSlots, std::accumulate(nodes.bufferStatusSH.begin(), nodes.bufferStatusSH.end(), 0));
 
-            // Remove 1-hop and 2-hop neighbors from available nodes to avoid interference
-            std::vector<int> neighbors = findNodesWithinOneAndTwoHops(selectedNodeId);
-            for (int neighborId : neighbors) {
-                availableNodes.erase(neighborId);
-            }
-            recordTransmissionTimeSH(selectedNodeId, slotStartTime);
+    SchedulingSnapshotSH snapshot = createSnapshotSH();
+    std::vector<int> bufferStatusBefore;
+    if (scheduleTrace.isOpen()) {
+        bufferStatusBefore = nodes.bufferStatusSH;
+    }
+    std::vector<std::vector<int>> assignedSlots;
+    core.assignSlotsSH(snapshot, *this, assignedSlots);
+
+    for (int index = 0; index < (int)assignedSlots.size(); ++index) {
+        if (assignedSlots[index].empty()) {
+            continue;
+        }
+        int nodeId = snapshot.nodeIds[index];
+        nodeToSlotsMapSH[nodeId] = assignedSlots[index];
+        for (int localSlot : assignedSlots[index]) {
+            metricsSH.addTransmission(localSlot);
         }
+        // Decrement the buffer status for SH, an empty buffer is not considered again in this frame
+        nodes.bufferStatusSH[nodeId] = std::max(0, nodes.bufferStatusSH[nodeId] - (int)assignedSlots[index].size());
+        recordTransmissionTimeSH(nodeId, nextFrameStartTime + (assignedSlots[index].back() * slotDuration));
     }
     slotToNodesMapSH = createSlotToNodesMap(nodeToSlotsMapSH);
+    if (scheduleTrace.isOpen()) {
+        std::vector<std::vector<int>> slotNodes(buildGraphIntervalSlots);
+        for (const auto& slotNodesPair : slotToNodesMapSH) {
+            slotNodes[slotNodesPair.first] = slotNodesPair.second;
+        }
+        scheduleTrace.writeFrameSH(nextFrameStartGlobalSlotIndex, bufferStatusBefore, slotNodes);
+    }
+    PHASE_TIMER(phaseTimers, PHASE_LOGGING, simTime().dbl());
     EV << "Assign slots for the shared channel." << endl;
     printSlotAssignments(slotToNodesMapSH);
     // Optionally, show the updated buffer status
     EV << "Updated Buffer Status SH:" << endl;
-    printBufferStatus(bufferStatusSH);
+    printBufferStatus(nodes.bufferStatusSH);
+}
+
+void AbstractLdacsTdmaScheduler::assignIncrementalSlotsSH(int nodeId) {
+    PHASE_TIMER(phaseTimers, PHASE_ASSIGN_INCREMENTAL_SH, simTime().dbl());
+    if (localToGlobalSlotMappingSH.empty()) {
+        return; // No frame has been scheduled yet
+    }
+    int frameStartGlobalSlotIndex = localToGlobalSlotMappingSH[0];
+    if (frameStartGlobalSlotIndex > getCurrentGlobalSlotIndex()) {
+        return; // The last half slot before a frame, its schedule has already been pushed
+    }
+    // Slots that already started or were used by a P2P pass to avoid SH collisions are left alone
+    int firstLocalSlotIndex = std::max(getCurrentGlobalSlotIndex() + 1, unplannedGlobalSlotP2P) - frameStartGlobalSlotIndex;
+
+    std::vector<int>& assignedSlots = nodeToSlotsMapSH[nodeId];
+    if (!assignedSlots.empty() && assignedSlots.back() >= firstLocalSlotIndex) {
+        return; // A grant later in this frame already serves the new packets
+    }
+
+    // A node that was idle at the last graph build has no conflict row, its 2-hop neighbourhood is searched around its position
+    const ConflictSets& conflictSets = core.getConflictSets();
+    int graphIndex = core.getGraphIndex(nodeId);
+    Coord position = nodes.mobilityModules[nodeId]->getCurrentPosition();
+    std::vector<bool> conflictingGraphNodes;
+    if (graphIndex == -1) {
+        std::vector<int> indices;
+        core.findGraphNodesWithinTwoHops(NodePosition(position.x, position.y, position.z), indices);
+        conflictingGraphNodes.assign(core.getGraphNodeIds().size(), false);
+        for (int index : indices) {
+            conflictingGraphNodes[index] = true;
+        }
+    }
+    auto conflictsWith = [&](int otherNodeId) {
+        int otherGraphIndex = core.getGraphIndex(otherNodeId);
+        if (otherGraphIndex == -1) {
+            // Another mid-frame grant outside the graph, two nodes can only be within two hops if at most twice the range apart
+            return position.distance(nodes.mobilityModules[otherNodeId]->getCurrentPosition()) <= 2 * communicationRange;
+        }
+        return graphIndex != -1 ? conflictSets.conflicts(graphIndex, otherGraphIndex) : (bool)conflictingGraphNodes[otherGraphIndex];
+    };
+
+    int remaining = nodes.bufferStatusSH[nodeId];
+    int addedSlots = 0;
+    for (int localSlot = std::max(0, firstLocalSlotIndex); localSlot < buildGraphIntervalSlots && remaining > 0; ++localSlot) {
+        double slotStartTime = (frameStartGlobalSlotIndex + localSlot) * slotDuration;
+        if (!isEligibleForReassignmentSH(nodeId, slotStartTime)) {
+            continue;
+        }
+        // The slot is free for this node if no node within two hops already transmits in it
+        bool conflict = false;
+        auto slotIt = slotToNodesMapSH.find(localSlot);
+        if (slotIt != slotToNodesMapSH.end()) {
+            for (int otherNodeId : slotIt->second) {
+                if (conflictsWith(otherNodeId)) {
+                    conflict = true;
+                    break;
+                }
+            }
+        }
+        if (conflict) {
+            continue;
+        }
+        assignedSlots.push_back(localSlot);
+        slotToNodesMapSH[localSlot].push_back(nodeId);
+        metricsSH.addTransmission(localSlot);
+        recordTransmissionTimeSH(nodeId, slotStartTime); // Later slots respect minReassignmentDurationSH to this one
+        --remaining;
+        ++addedSlots;
+    }
+    if (addedSlots == 0) {
+        return;
+    }
+    metricsSH.addBacklog(nodes.bufferStatusSH[nodeId]);
+    nodes.bufferStatusSH[nodeId] = remaining;
+    if (scheduleTrace.isOpen()) {
+        scheduleTrace.writeGrantSH(simTime().raw(), nodeId, std::vector<int>(assignedSlots.end() - addedSlots, assignedSlots.end()));
+    }
+    EV << "SH channel: " << getHostName(nodeId) << " got " << addedSlots << " mid-frame slots up to local slot " << assignedSlots.back() << endl;
+    nodes.clients[nodeId]->setScheduleSH(assignedSlots, true);
 }
 
 void AbstractLdacsTdmaScheduler::assignSlotsP2P() {
+    PHASE_TIMER(phaseTimers, PHASE_ASSIGN_P2P, simTime().dbl());
     initializeP2PAssignment();
     updateSlotTimeInfo();
 
@@ -199,104 +425,265 @@ void AbstractLdacsTdmaScheduler::assignSlotsP2P() {
         // EV_INFO << currentGlobalSlotIndex << "Next Global slot index in P2P schedule does not exist in the SH schedule." << endl;
     }
 
-    // Reset for each new assignment
-    std::set<int> assignedRecipientsForCurrentSlot;
-    assignedRecipientsForCurrentSlot.clear();
-    std::unordered_set<int> availableNodes = populateAvailableNodesP2P(nextSlotStartTime);
-    int numberOfAssignedP2PLinks = 0;
-
-    while (!availableNodes.empty() && numberOfAssignedP2PLinks < maxP2PLinks) {
-        int selectedNodeId = selectRandomNode(availableNodes);
-        // Get the MAC address of the head of queue packet's intended recipient
-        auto macModule = clients[selectedNodeId];
-        auto recipientMac = macModule->getHeadOfQueueMacP2P();
-        int recipientId = findNodeIdByMac(recipientMac);
-
-        bool txSlotExistsInSH = checkIfSlotExistsInSH(selectedNodeId, nextLocalSlotIndex);
-        bool rxSlotExistsInSH = checkIfSlotExistsInSH(recipientId, nextLocalSlotIndex);
-        bool txSlotExistsInP2P = checkIfSlotExistsInP2P(selectedNodeId, nextGlobalSlotIndex);
-        bool rxSlotExistsInP2P = checkIfSlotExistsInP2P(recipientId, nextGlobalSlotIndex);
-        // Check if the recipient has not been assigned in the current slot
-        bool isRecipientUniqueForSlot = assignedRecipientsForCurrentSlot.find(recipientId) == assignedRecipientsForCurrentSlot.end();
-
-        EV << "Slot Assignment Details:" << endl
-            << "  - Selected Node: " << getHostName(selectedNodeId) << endl
-            << "  - Recipient: " << getHostName(recipientId) << endl
-            << "  - TX Slot in SH Schedule: " << (txSlotExistsInSH ? "Exists" : "Does Not Exist") << endl
-            << "  - RX Slot in SH Schedule: " << (rxSlotExistsInSH ? "Exists" : "Does Not Exist") << endl
-            << "  - TX Slot in P2P Schedule: " << (txSlotExistsInP2P ? "Exists" : "Does Not Exist") << endl
-            << "  - RX Slot in P2P Schedule: " << (rxSlotExistsInP2P ? "Exists" : "Does Not Exist") << endl
-            << "  - Recipient Unique for Slot: " << (isRecipientUniqueForSlot ? "Yes" : "No") << endl;
-
-        // Before the final assignment check, ensure the recipient hasn't been selected for the current slot
-        if (!txSlotExistsInSH && !txSlotExistsInP2P && !rxSlotExistsInSH && !rxSlotExistsInP2P && isRecipientUniqueForSlot) {   
-            nodeToSlotsMapP2P[selectedNodeId].push_back(nextGlobalSlotIndex); // Assign the selected node to this slot for P2P
-            assignedRecipientsForCurrentSlot.insert(recipientId); // Mark this recipient as assigned for the current slot
-            // Recalculate number of assigned P2P links for this slot after successful assignment
-            numberOfAssignedP2PLinks = countAssignmentsForSlot(nodeToSlotsMapP2P, nextGlobalSlotIndex);
-
-            // Decrement the buffer status for P2P
-            if (--bufferStatusP2P[selectedNodeId] <= 0) {
-                bufferStatusP2P.erase(selectedNodeId); // Remove from future considerations
+    std::vector<int> bufferStatusBefore;
+    if (scheduleTrace.isOpen()) {
+        bufferStatusBefore = nodes.bufferStatusP2P;
+    }
+
+    // Plan up to p2pPlanningHorizonSlots slots, but not beyond the SH frame whose schedule is known
+    plannedSlotsP2P = std::max(1, std::min(p2pPlanningHorizonSlots, buildGraphIntervalSlots - nextLocalSlotIndex));
+    metricsP2P.begin(plannedSlotsP2P, std::accumulate(nodes.bufferStatusP2P.begin(), nodes.bufferStatusP2P.end(), 0));
+    for (int offset = 0; offset < plannedSlotsP2P; ++offset) {
+        int globalSlotIndex = nextGlobalSlotIndex + offset;
+        int localSlotIndex = nextLocalSlotIndex + offset;
+        double slotStartTime = globalSlotIndex * slotDuration;
+        std::vector<int> reservedNodes;
+        int reservedLinks = assignReservedLinksP2P(globalSlotIndex, localSlotIndex, slotStartTime, reservedNodes);
+
+        SchedulingSnapshotP2P snapshot = createSnapshotP2P(localSlotIndex, slotStartTime);
+        // Nodes of reserved links are unavailable to the policy just like nodes transmitting on SH
+        for (int nodeId : reservedNodes) {
+            snapshot.busySH[nodeId] = true;
+        }
+        snapshot.maxLinks -= reservedLinks;
+        std::vector<P2PLink> links;
+        core.assignLinksP2P(snapshot, *this, links);
+
+        for (const P2PLink& link : links) {
+            assignLinkP2P(link.transmitter, link.recipient, globalSlotIndex, slotStartTime);
+            if (reservationsP2P.isEnabled() && isInRangeP2P(link.transmitter, link.recipient)) {
+                reservationsP2P.recordDynamicGrant(link.transmitter, link.recipient, globalSlotIndex);
             }
-            availableNodes.erase(selectedNodeId); // Remove from future considerations in this slot
-            availableNodes.erase(recipientId); // Remove from future considerations in this slot
-        } else {
-            availableNodes.erase(selectedNodeId); // Remove the node if it already has this slot assigned in SH or P2P
-            if (rxSlotExistsInSH || rxSlotExistsInP2P) {
-                availableNodes.erase(recipientId); // Remove from future considerations in this slot
+        }
+    }
+    reservationsP2P.expireHistory(nextGlobalSlotIndex);
+    emitMetricsP2P();
+    unplannedGlobalSlotP2P = nextGlobalSlotIndex + plannedSlotsP2P;
+    if (scheduleTrace.isOpen()) {
+        std::vector<std::vector<P2PLink>> slotLinks(plannedSlotsP2P);
+        for (const auto& nodeSlotsPair : nodeToSlotsMapP2P) {
+            const std::vector<int>& recipients = linkRecipientsP2P[nodeSlotsPair.first];
+            for (size_t i = 0; i < nodeSlotsPair.second.size(); ++i) {
+                slotLinks[nodeSlotsPair.second[i] - nextGlobalSlotIndex].push_back(P2PLink{nodeSlotsPair.first, recipients[i]});
             }
-            // availableNodes.erase(recipientId); // Remove from future considerations in this slot
         }
-        recordTransmissionTimeP2P(selectedNodeId, nextSlotStartTime);
+        scheduleTrace.writePassP2P(nextGlobalSlotIndex, bufferStatusBefore, slotLinks);
     }
     slotToNodesMapP2P = createSlotToNodesMap(nodeToSlotsMapP2P);
+    PHASE_TIMER(phaseTimers, PHASE_LOGGING, simTime().dbl());
     EV << "Assign slots for the point-to-point channel." << endl;
     // printSlotAssignments(slotToNodesMapP2P);
     printNodeSlotAssignments(nodeToSlotsMapP2P);
 }
 
+void AbstractLdacsTdmaScheduler::assignLinkP2P(int transmitter, int recipient, int globalSlotIndex, double slotStartTime) {
+    EV << "Slot Assignment Details:" << endl
+        << "  - Global Slot: " << globalSlotIndex << endl
+        << "  - Selected Node: " << getHostName(transmitter) << endl
+        << "  - Recipient: " << getHostName(recipient) << endl;
+
+    nodeToSlotsMapP2P[transmitter].push_back(globalSlotIndex); // Assign the selected node to this slot for P2P
+    metricsP2P.addTransmission(globalSlotIndex - nextGlobalSlotIndex);
+    linkRecipientsP2P[transmitter].push_back(recipient);
+    nodes.serveDestinationP2P(transmitter, recipient);
+    // Decrement the buffer status for P2P, later slots of the horizon only see the remaining packets
+    if (--nodes.bufferStatusP2P[transmitter] <= 0) {
+        nodes.bufferStatusP2P[transmitter] = 0; // Remove from future considerations
+    }
+    recordTransmissionTimeP2P(transmitter, slotStartTime);
+}
+
+int AbstractLdacsTdmaScheduler::assignReservedLinksP2P(int globalSlotIndex, int localSlotIndex, double slotStartTime, std::vector<int>& reservedNodes) {
+    if (!reservationsP2P.isEnabled()) {
+        return 0;
+    }
+    std::vector<int> due;
+    reservationsP2P.collectDue(globalSlotIndex, due);
+    int reservedLinks = 0;
+    for (int index : due) {
+        int transmitter = reservationsP2P.at(index).transmitter;
+        int recipient = reservationsP2P.at(index).recipient;
+        bool clash = reservedLinks >= maxP2PLinks
+                || checkIfSlotExistsInSH(transmitter, localSlotIndex) || checkIfSlotExistsInSH(recipient, localSlotIndex)
+                || std::find(reservedNodes.begin(), reservedNodes.end(), transmitter) != reservedNodes.end()
+                || std::find(reservedNodes.begin(), reservedNodes.end(), recipient) != reservedNodes.end();
+        if (clash) {
+            reservationsP2P.completeOccurrence(index, P2PReservationTable::SKIPPED);
+        } else if (nodes.getDestinationBacklogP2P(transmitter, recipient) <= 0) {
+            EV << "Reserved P2P slot " << globalSlotIndex << " of " << getHostName(transmitter) << " is idle" << endl;
+            reservationsP2P.completeOccurrence(index, P2PReservationTable::IDLE);
+        } else {
+            assignLinkP2P(transmitter, recipient, globalSlotIndex, slotStartTime);
+            reservedNodes.push_back(transmitter);
+            reservedNodes.push_back(recipient);
+            ++reservedLinks;
+            reservationsP2P.completeOccurrence(index, P2PReservationTable::SERVED);
+        }
+    }
+    reservationsP2P.removeReleased();
+    return reservedLinks;
+}
+
+bool AbstractLdacsTdmaScheduler::isInRangeP2P(int transmitter, int recipient) {
+    return core.isInRange(transmitter, recipient);
+}
+
 void AbstractLdacsTdmaScheduler::createScheduleSH() {
+    if (pullBufferStatus) {
+        pullBufferStatusSH();
+    }
     // Assuming assignSlotsSH method correctly populates nodeToSlotsMapSH
     assignSlotsSH();
+    pushScheduleSH();
+}
 
+void AbstractLdacsTdmaScheduler::pushScheduleSH() {
+    PHASE_TIMER(phaseTimers, PHASE_NOTIFY_MAC, simTime().dbl());
     // Communicate the assigned slots to each corresponding MAC instance
     for (const auto& nodeSlotsPair : nodeToSlotsMapSH) {
         int nodeId = nodeSlotsPair.first;
         const std::vector<int>& assignedSlots = nodeSlotsPair.second;
 
-        // Assuming 'clients' maps node IDs to their corresponding MAC instances
-        if (clients.find(nodeId) != clients.end()) {
-            clients[nodeId]->setScheduleSH(assignedSlots);
+        // The node table maps node IDs to their corresponding MAC instances
+        if (nodes.contains(nodeId)) {
+            nodes.clients[nodeId]->setScheduleSH(assignedSlots);
         }
     }
 }
 
 void AbstractLdacsTdmaScheduler::createScheduleP2P() {
+    if (pullBufferStatus) {
+        pullBufferStatusP2P();
+    }
     assignSlotsP2P(); // Populate nodeToSlotsMapP2P with the new assignments
+    pushScheduleP2P();
+}
 
+void AbstractLdacsTdmaScheduler::pushScheduleP2P() {
+    PHASE_TIMER(phaseTimers, PHASE_NOTIFY_MAC, simTime().dbl());
     for (const auto& nodeSlotsPair : nodeToSlotsMapP2P) {
         int nodeId = nodeSlotsPair.first;
         const std::vector<int>& assignedSlots = nodeSlotsPair.second;
 
         // Check if this client exists in our client map
-        if (clients.find(nodeId) != clients.end()) {
-            // Check if only one slot has been assigned
-            if (assignedSlots.size() == 1) {
-                // Assign the slot to the client
-                int assignedSlot = assignedSlots.front();
-                clients[nodeId]->setScheduleP2P(assignedSlot);
-            } else if (assignedSlots.empty()) {
-                // If no slots have been assigned, set to -1 to indicate no slot assignment
-                clients[nodeId]->setScheduleP2P(-1);
-            } else {
-                // More than one slot has been assigned, which is an error under current assumptions
-                throw cRuntimeError("Error: Client %d has been assigned more than one slot.", nodeId);
+        if (nodes.contains(nodeId)) {
+            // All grants of the planning horizon are pushed at once, each names the destination whose virtual output queue is served
+            std::vector<P2PGrant> grants;
+            for (size_t i = 0; i < assignedSlots.size(); ++i) {
+                grants.push_back(P2PGrant{assignedSlots[i], nodes.macAddresses[linkRecipientsP2P[nodeId][i]]});
             }
+            nodes.clients[nodeId]->setScheduleP2P(grants);
+        }
+    }
+}
+
+void AbstractLdacsTdmaScheduler::advanceReplay() {
+    replayRecord = scheduleReplay.next();
+    if (replayRecord == ScheduleTrace::GRANT_SH) {
+        simtime_t grantTime = SimTime::fromRaw(scheduleReplay.getFrameSH().grantTime);
+        if (grantTime < simTime()) {
+            throw cRuntimeError("Schedule replay trace has a mid-frame grant before the current time.");
         }
+        scheduleAt(grantTime, replayGrantSHSelfMessage);
+    }
+    else if (replayRecord == ScheduleTrace::END && !scheduleReplay.ok()) {
+        throw cRuntimeError("Schedule replay trace is damaged: %s.", scheduleReplay.getError().c_str());
     }
 }
 
+void AbstractLdacsTdmaScheduler::replayFrameSH() {
+    const ScheduleTraceFrameSH& frame = scheduleReplay.getFrameSH();
+    if (replayRecord != ScheduleTrace::FRAME_SH || frame.frameStartSlot != getNextFrameStartGlobalSlotIndex()) {
+        throw cRuntimeError("Schedule replay trace has no SH frame for global slot %d.", getNextFrameStartGlobalSlotIndex());
+    }
+    // Same map operations as initializeSHAssignment(), so the MACs are handed their grants in the recorded order
+    nodeToSlotsMapSH.clear();
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        nodeToSlotsMapSH[nodeId] = std::vector<int>{};
+    }
+    emitMetricsSH();
+    metricsSH.begin(frame.slotNodes.size(), std::accumulate(frame.bufferStatus.begin(), frame.bufferStatus.end(), 0));
+    for (int slot = 0; slot < (int)frame.slotNodes.size(); ++slot) {
+        for (int nodeId : frame.slotNodes[slot]) {
+            if (!nodes.contains(nodeId)) {
+                throw cRuntimeError("Schedule replay trace assigns unknown node %d.", nodeId);
+            }
+            nodeToSlotsMapSH[nodeId].push_back(slot);
+            metricsSH.addTransmission(slot);
+        }
+    }
+    pushScheduleSH();
+    advanceReplay();
+}
+
+void AbstractLdacsTdmaScheduler::replayPassP2P() {
+    const ScheduleTracePassP2P& pass = scheduleReplay.getPassP2P();
+    if (replayRecord != ScheduleTrace::PASS_P2P || pass.firstSlot != getNextGlobalSlotIndex()) {
+        throw cRuntimeError("Schedule replay trace has no P2P pass for global slot %d.", getNextGlobalSlotIndex());
+    }
+    nodeToSlotsMapP2P.clear();
+    linkRecipientsP2P.clear();
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        nodeToSlotsMapP2P[nodeId].clear();
+    }
+    metricsP2P.begin(pass.slotLinks.size(), std::accumulate(pass.bufferStatus.begin(), pass.bufferStatus.end(), 0));
+    for (int offset = 0; offset < (int)pass.slotLinks.size(); ++offset) {
+        for (const P2PLink& link : pass.slotLinks[offset]) {
+            if (!nodes.contains(link.transmitter) || !nodes.contains(link.recipient)) {
+                throw cRuntimeError("Schedule replay trace assigns unknown node %d or %d.", link.transmitter, link.recipient);
+            }
+            nodeToSlotsMapP2P[link.transmitter].push_back(pass.firstSlot + offset);
+            linkRecipientsP2P[link.transmitter].push_back(link.recipient);
+            metricsP2P.addTransmission(offset);
+        }
+    }
+    emitMetricsP2P();
+    plannedSlotsP2P = std::max(1, (int)pass.slotLinks.size());
+    pushScheduleP2P();
+    advanceReplay();
+}
+
+void AbstractLdacsTdmaScheduler::replayGrantSH() {
+    const ScheduleTraceFrameSH& grant = scheduleReplay.getFrameSH();
+    if (!nodes.contains(grant.nodeId)) {
+        throw cRuntimeError("Schedule replay trace assigns unknown node %d.", grant.nodeId);
+    }
+    std::vector<int>& assignedSlots = nodeToSlotsMapSH[grant.nodeId];
+    assignedSlots.insert(assignedSlots.end(), grant.localSlots.begin(), grant.localSlots.end());
+    if (metricsSH.isActive()) {
+        // The trace does not hold the node's backlog at the grant, it had at least one packet per slot
+        metricsSH.addBacklog(grant.localSlots.size());
+        for (int localSlot : grant.localSlots) {
+            metricsSH.addTransmission(localSlot);
+        }
+    }
+    nodes.clients[grant.nodeId]->setScheduleSH(assignedSlots, true);
+    advanceReplay();
+}
+
+void AbstractLdacsTdmaScheduler::emitMetricsSH() {
+    if (!metricsSH.isActive()) {
+        return;
+    }
+    const ChannelMetrics& metrics = metricsSH.get();
+    utilization = metrics.getUtilization();
+    emit(utilizationSignal, utilization);
+    emit(spatialReuseSHSignal, metrics.getSpatialReuse());
+    emit(servedSHSignal, (long)metrics.transmissions);
+    emit(backlogSHSignal, (long)metrics.backlog);
+    emit(unassignedBacklogSHSignal, (long)metrics.getUnassignedBacklog());
+}
+
+void AbstractLdacsTdmaScheduler::emitMetricsP2P() {
+    const ChannelMetrics& metrics = metricsP2P.get();
+    emit(utilizationP2PSignal, metrics.getUtilization());
+    emit(linkUtilizationP2PSignal, metrics.slots > 0 ? (double)metrics.transmissions / (metrics.slots * maxP2PLinks) : 0);
+    emit(spatialReuseP2PSignal, metrics.getSpatialReuse());
+    emit(servedP2PSignal, (long)metrics.transmissions);
+    emit(backlogP2PSignal, (long)metrics.backlog);
+    emit(unassignedBacklogP2PSignal, (long)metrics.getUnassignedBacklog());
+}
+
 void AbstractLdacsTdmaScheduler::updateSlotTimeInfo() {
     currentGlobalSlotIndex = getCurrentGlobalSlotIndex();
     nextGlobalSlotIndex = getNextGlobalSlotIndex();
@@ -312,22 +699,23 @@ void AbstractLdacsTdmaScheduler::initializeSHAssignment() {
     nodeToSlotsMapSH.clear();
     slotToNodesMapSH.clear();
     localToGlobalSlotMappingSH.clear();
-    for (const auto& node : bufferStatusSH) {
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
         // Assuming initialization with an empty vector or with predefined values if needed
-        nodeToSlotsMapSH[node.first] = std::vector<int>{}; // Initialize with an empty vector
+        nodeToSlotsMapSH[nodeId] = std::vector<int>{}; // Initialize with an empty vector
     }
 
     EV << "SH Buffer Status:" << endl;
-    printBufferStatus(bufferStatusSH);
+    printBufferStatus(nodes.bufferStatusSH);
 }
 
 void AbstractLdacsTdmaScheduler::initializeP2PAssignment() {
     nodeToSlotsMapP2P.clear();
-    for (const auto& node : bufferStatusP2P) {
-        nodeToSlotsMapP2P[node.first].clear();
+    linkRecipientsP2P.clear();
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        nodeToSlotsMapP2P[nodeId].clear();
     }
     EV << "P2P Buffer Status:" << endl;
-    printBufferStatus(bufferStatusP2P);
+    printBufferStatus(nodes.bufferStatusP2P);
 
     EV_INFO << "Local to Global Slot Mapping:" << endl;
     for (const auto& pair : localToGlobalSlotMappingSH) {
@@ -384,107 +772,67 @@ double AbstractLdacsTdmaScheduler::getNextSlotStartTime() {
     return nextSlotStart;
 }
 
-std::pair<std::vector<std::vector<int>>, std::unordered_map<int, int>>
-AbstractLdacsTdmaScheduler::createAdjacencyMatrixAndNodeMapping() {
-    std::unordered_map<int, int> tempMapping;
-    std::vector<int> activeNodes;
-    int index = 0;
-
-    // Filter nodes with non-empty buffers and prepare temporary mapping
-    for (const auto& item : bufferStatusSH) {
-        if (item.second > 0) { // Check for non-empty buffer
-            tempMapping[item.first] = index;
-            activeNodes.push_back(item.first);
-            ++index;
-        }
-    }
-
-    int activeCount = activeNodes.size();
-    std::vector<std::vector<int>> adjacencyMatrix(activeCount, std::vector<int>(activeCount, 0));
-
-    // Fill adjacency matrix
-    for (int i = 0; i < activeCount; ++i) {
-        auto mobilityI = mobilityModules[activeNodes[i]];
-        for (int j = i + 1; j < activeCount; ++j) { // Start from i+1 to avoid duplicate calculations
-            auto mobilityJ = mobilityModules[activeNodes[j]];
-            double distance = mobilityI->getCurrentPosition().distance(mobilityJ->getCurrentPosition());
-
-            // Check if within communication range (Use this->communicationRange directly)
-            if (distance <= this->communicationRange) {
-                adjacencyMatrix[i][j] = adjacencyMatrix[j][i] = 1; // Symmetric matrix, use integers 1 for true, 0 for false
-            }
-        }
-    }
-
-    return {adjacencyMatrix, tempMapping};
-}
-
 void AbstractLdacsTdmaScheduler::buildGraph() {
+    PHASE_TIMER(phaseTimers, PHASE_BUILD_GRAPH, simTime().dbl());
     // Implementation of your graph building or updating logic
     EV << "Building or updating the graph at " << simTime() << endl;
-    // Retrieve adjacency matrix and node mapping
-    auto result = createAdjacencyMatrixAndNodeMapping();
-    adjacencyMatrix = std::move(result.first); // Store the adjacency matrix in the class member variable
-    nodeMapping = std::move(result.second); // Store the node mapping in the class member variable
-
-    // Print the adjacency matrix
-    EV << "Adjacency Matrix:" << endl;
-    for (int i = 0; i < adjacencyMatrix.size(); i++) {
-        for (int j = 0; j < adjacencyMatrix[i].size(); j++) {
-            EV << adjacencyMatrix[i][j] << " ";
+    // The graph only takes backlogged nodes, so pulled queue lengths have to be fresh before the filter below
+    if (pullBufferStatus) {
+        pullBufferStatusSH();
+    }
+    // Only nodes with a non-empty SH buffer take part, positions are snapshot once per rebuild
+    std::vector<int> activeNodes;
+    std::vector<NodePosition> nodePositions;
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        if (nodes.bufferStatusSH[nodeId] > 0) { // Check for non-empty buffer
+            const Coord& position = nodes.mobilityModules[nodeId]->getCurrentPosition();
+            activeNodes.push_back(nodeId);
+            nodePositions.emplace_back(position.x, position.y, position.z);
+        }
+    }
+    core.buildGraph(activeNodes, nodePositions);
+    if (core.getParameters().incrementalGraph) {
+        EV << "Incremental graph update: " << core.getNumSearches() << " of " << activeNodes.size() << " nodes searched" << endl;
+    }
+    // A topology change that separates the two ends of a reserved P2P link releases the reservation
+    int releasedReservations = reservationsP2P.release([this](const P2PReservation& reservation) {
+        return !isInRangeP2P(reservation.transmitter, reservation.recipient);
+    });
+    if (releasedReservations > 0) {
+        EV << "Released " << releasedReservations << " P2P reservations after a topology change" << endl;
+    }
+    printGraph(activeNodes);
+}
+
+void AbstractLdacsTdmaScheduler::printGraph(const std::vector<int>& activeNodes) {
+    PHASE_TIMER(phaseTimers, PHASE_LOGGING, simTime().dbl());
+    // Print the neighbour lists
+    const ConnectivityGraph& connectivityGraph = core.getGraph();
+    EV << "Connectivity Graph (" << connectivityGraph.getNumVertices() << " nodes, " << connectivityGraph.getNumEdges() << " edges):" << endl;
+    for (int i = 0; i < connectivityGraph.getNumVertices(); i++) {
+        EV << "Index " << i << ": ";
+        for (int neighbour : connectivityGraph.getNeighbours(i)) {
+            EV << neighbour << " ";
         }
         EV << endl;
     }
 
     // Print the node mapping
     EV << "Node Mapping:" << endl;
-    for (const auto& pair : nodeMapping) {
-        EV << "Node ID " << pair.first << " maps to Index " << pair.second << endl;
+    for (int index = 0; index < (int)activeNodes.size(); ++index) {
+        EV << "Node ID " << activeNodes[index] << " maps to Index " << index << endl;
     }
 }
 
-std::vector<int> AbstractLdacsTdmaScheduler::findNodesWithinOneAndTwoHops(int NodeID) {
-    std::unordered_set<int> resultNodes; // Use a set to avoid duplicates
+std::vector<int> AbstractLdacsTdmaScheduler::findNodesWithinOneAndTwoHops(int nodeId) {
     std::vector<int> hopsOneAndTwo;
-
-    // Check if the NodeID exists in nodeMapping
-    if (nodeMapping.find(NodeID) == nodeMapping.end()) {
-        return {}; // Return an empty vector if the node ID doesn't exist
-    }
-
-    int nodeGraphID = nodeMapping[NodeID]; // Get the index in the adjacency matrix for the given node ID
-
-    // First, add all 1-hop neighbors
-    for (int i = 0; i < adjacencyMatrix[nodeGraphID].size(); ++i) {
-        if (adjacencyMatrix[nodeGraphID][i] == 1) { // Direct connection exists
-            resultNodes.insert(i); // Add to results as index; convert to ID later
-            // Then, find 2-hop neighbors by exploring the neighbors of i
-            for (int j = 0; j < adjacencyMatrix[i].size(); ++j) {
-                if (adjacencyMatrix[i][j] == 1 && j != nodeGraphID) { // Ensure not to add the original node
-                    resultNodes.insert(j); // Add to results as index; convert to ID later
-                }
-            }
-        }
-    }
-
-    // Convert indices back to node IDs
-    for (const auto& idx : resultNodes) {
-        // Assuming a reverse mapping exists or you can find IDs by index
-        for (const auto& mapping : nodeMapping) {
-            if (mapping.second == idx) {
-                hopsOneAndTwo.push_back(mapping.first);
-                break; // Found the ID for this index, move to next
-            }
-        }
-    }
-
+    core.findNodesWithinTwoHops(nodeId, hopsOneAndTwo);
     return hopsOneAndTwo;
 }
 
 std::string AbstractLdacsTdmaScheduler::getHostName(int nodeId) {
-    auto clientIt = clients.find(nodeId);
-    if (clientIt != clients.end()) {
-        cModule* macModule = clientIt->second;
+    if (nodes.contains(nodeId)) {
+        cModule* macModule = nodes.clients[nodeId];
         cModule* wlanModule = macModule->getParentModule();
         cModule* hostModule = wlanModule->getParentModule();
         return hostModule->getFullName();
@@ -555,15 +903,15 @@ void AbstractLdacsTdmaScheduler::printNodeSlotAssignments(const NodeToSlotsMap&
     }
 }
 
-void AbstractLdacsTdmaScheduler::printBufferStatus(const map<int, int>& buffer) {
+void AbstractLdacsTdmaScheduler::printBufferStatus(const std::vector<int>& buffer) {
     EV << "       " << std::left << std::setw(20) << "Node" << "|   Buffer Status" << endl;
     EV << "---------------------------+----------------" << endl;
-    for (const auto& node : buffer) {
-        if (node.second >= 0) {
-            std::string nodeName = getHostName(node.first); // Assuming getHostName returns a string
+    for (int nodeId = 0; nodeId < (int)buffer.size(); ++nodeId) {
+        if (buffer[nodeId] >= 0) {
+            std::string nodeName = getHostName(nodeId); // Assuming getHostName returns a string
             // Adjust the width according to your needs
             EV << "       " << std::left << std::setw(20) << nodeName << "|   ";
-            EV << std::left << std::setw(15) << node.second << endl;
+            EV << std::left << std::setw(15) << buffer[nodeId] << endl;
         }
     }
 }
@@ -580,52 +928,26 @@ int AbstractLdacsTdmaScheduler::findLocalSlotIndex(int currentGlobalSlotID) {
 }
 
 // Populates the set of available nodes based on their eligibility and buffer status.
-std::unordered_set<int> AbstractLdacsTdmaScheduler::populateAvailableNodesSH(double slotStart) {
-    std::unordered_set<int> availableNodes;
-    // Populate availableNodes with nodes that have a positive buffer status for P2P
-    // Determine available nodes based on the copied nodeMapping and buffer status
-    for (const auto& node : nodeMapping) {
-        if (bufferStatusSH[node.first] > 0) {
-            // Check if the node is eligible for reassignment based on the last assignment time
-            auto lastAssignedIt = lastAssignedSH.find(node.first);
-            bool isEligibleForReassignment = true;
-            if (lastAssignedIt != lastAssignedSH.end()) {
-                // Calculate elapsed time since last assignment for this node
-                simtime_t elapsedTimeSinceLastAssignment = slotStart - lastAssignedIt->second;
-                if (elapsedTimeSinceLastAssignment < minReassignmentDurationSH) {
-                    isEligibleForReassignment = false;
-                }
-            }
-            if (isEligibleForReassignment) {
-                availableNodes.insert(node.first);
-            }
-        }
-    }
-    return availableNodes;
+SchedulingSnapshotSH AbstractLdacsTdmaScheduler::createSnapshotSH() {
+    return core.createSnapshotSH(nodes.bufferStatusSH, nodes.lastAssignedSH, nextFrameStartTime);
 }
 
-// Populates the set of available nodes based on their eligibility and buffer status.
-std::unordered_set<int> AbstractLdacsTdmaScheduler::populateAvailableNodesP2P(double slotStart) {
-    std::unordered_set<int> availableNodes;
-    // Populate availableNodes with nodes that have a positive buffer status for P2P
-    for (const auto& node : bufferStatusP2P) {
-        if (bufferStatusP2P[node.first] > 0) {
-            auto lastAssignedIt = lastAssignedP2P.find(node.first); // Or lastAssignedP2P for P2P
-            bool isEligibleForReassignment = true;
-            if (lastAssignedIt != lastAssignedP2P.end()) {
-                // Calculate elapsed time since last assignment for this node
-                simtime_t elapsedTimeSinceLastAssignment = slotStart - lastAssignedIt->second;
-                bool checkoutput = elapsedTimeSinceLastAssignment < minReassignmentDurationP2P;
-                if (elapsedTimeSinceLastAssignment < minReassignmentDurationP2P) { // Or minReassignmentDurationP2P for P2P
-                    isEligibleForReassignment = false;
-                }
-            }
-            if (isEligibleForReassignment) {
-                availableNodes.insert(node.first);
-            }
-        }
+bool AbstractLdacsTdmaScheduler::isEligibleForReassignmentSH(int nodeId, double slotStart) {
+    // Check if the node is eligible for reassignment based on the last assignment time
+    return core.isEligibleSH(nodes.lastAssignedSH[nodeId], slotStart);
+}
+
+// Collects the nodes that may transmit in the given P2P slot based on their eligibility and buffer status.
+SchedulingSnapshotP2P AbstractLdacsTdmaScheduler::createSnapshotP2P(int localSlotIndex, double slotStartTime) {
+    std::vector<bool> busySH(nodes.size());
+    for (int nodeId = 0; nodeId < nodes.size(); ++nodeId) {
+        busySH[nodeId] = checkIfSlotExistsInSH(nodeId, localSlotIndex);
     }
-    return availableNodes;
+    return core.createSnapshotP2P(nodes.bufferStatusP2P, nodes.destinationsP2P, nodes.lastAssignedP2P, busySH, slotStartTime);
+}
+
+bool AbstractLdacsTdmaScheduler::isEligibleForReassignmentP2P(int nodeId, double slotStart) {
+    return core.isEligibleP2P(nodes.lastAssignedP2P[nodeId], slotStart);
 }
 
 bool AbstractLdacsTdmaScheduler::checkIfSlotExistsInSH(int nodeId, int localSlotIndex) {
@@ -638,51 +960,16 @@ bool AbstractLdacsTdmaScheduler::checkIfSlotExistsInSH(int nodeId, int localSlot
     return slotExistsInSH;
 }
 
-bool AbstractLdacsTdmaScheduler::checkIfSlotExistsInP2P(int nodeId, int globalSlotIndex) {
-    // Check if nodeId or recipientId exists in nodeToSlotsMapSH and if slot is in its vector
-    bool slotExistsInP2P = false;
-    if (nodeToSlotsMapP2P.find(nodeId) != nodeToSlotsMapP2P.end()) {
-            slotExistsInP2P = std::find(nodeToSlotsMapP2P[nodeId].begin(), 
-                                        nodeToSlotsMapP2P[nodeId].end(), globalSlotIndex) != nodeToSlotsMapP2P[nodeId].end();
-    }
-    return slotExistsInP2P;
-}
-
 int AbstractLdacsTdmaScheduler::findNodeIdByMac(MacAddress macAddress) {
-    int nodeId = -1;
-    // Find the recipient's nodeId using its MAC address
-    for (const auto& client : clientsMacAddress) {
-        if (client.second == macAddress) {
-            // EV_INFO << "Mac of recepient is: " << recipientMac << endl;
-            nodeId = client.first;
-            break;
-        }
-    }
-    return nodeId;
-} 
-
-int AbstractLdacsTdmaScheduler::selectRandomNode(const std::unordered_set<int>& availableNodes) {
-    if (availableNodes.empty()) {
-        throw std::runtime_error("No available nodes to select.");
-    }
-
-    std::random_device rd; 
-    std::mt19937 gen(rd()); 
-    std::uniform_int_distribution<> dist(0, availableNodes.size() - 1);
-
-    auto it = availableNodes.begin();
-    std::advance(it, dist(gen)); // Advance iterator it by the random distance
-    return *it; // Dereference iterator to get the selected node ID
+    // Find the recipient's nodeId using its MAC address, -1 if it is not registered
+    return nodes.findNodeIdByMac(macAddress);
 }
 
+int AbstractLdacsTdmaScheduler::uniformInt(int low, int high) {
+    // intuniform() draws from the module's configured RNG stream, so a seed fully determines the schedule
+    return intuniform(low, high);
+}
 
-
-int AbstractLdacsTdmaScheduler::countAssignmentsForSlot(const std::unordered_map<int, std::vector<int>>& map, int slotID) {
-    int count = 0;
-    for (const auto& pair : map) {
-        if (std::find(pair.second.begin(), pair.second.end(), slotID) != pair.second.end()) {
-            ++count;
-        }
-    }
-    return count;
+void AbstractLdacsTdmaScheduler::phaseCompleted(int phase, double seconds) {
+    phaseHistograms[phase]->collect(seconds);
 }
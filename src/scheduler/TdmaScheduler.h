@@ -18,6 +18,13 @@
 #define __INET_TDMA_SCHEDULER_H
 
 #include "../mac/TdmaMac.h"
+#include "NodeTable.h"
+#include "core/P2PReservations.h"
+#include "core/ParallelFor.h"
+#include "core/PhaseTimers.h"
+#include "core/ScheduleMetrics.h"
+#include "core/ScheduleTrace.h"
+#include "core/SchedulerCore.h"
 #include "inet/common/INETDefs.h"
 #include "inet/queueing/contract/IPacketQueue.h"
 #include "inet/linklayer/base/MacProtocolBase.h"
@@ -28,8 +35,8 @@
 #include "inet/mobility/contract/IMobility.h"
 #include <unordered_map>
 #include <unordered_set>
-#include <random>
-#include <iomanip> 
+#include <iomanip>
+#include <numeric>
 
 using namespace inet;
 using namespace std;
@@ -43,38 +50,62 @@ using SlotToNodesMap = std::map<int, std::vector<int>>; // Type alias for a map
  *    @author Musab Ahmed, Konrad Fuger, TUHH ComNets
  *    @date February 2024
  */
-class AbstractLdacsTdmaScheduler: public cSimpleModule
+class AbstractLdacsTdmaScheduler: public cSimpleModule, public IRandomSource, public IPhaseListener
 {
+    public:
+        // Hot-path phases timed if the model is built with -DLDACS_PHASE_TIMERS
+        enum Phase { PHASE_BUILD_GRAPH, PHASE_ASSIGN_SH, PHASE_ASSIGN_INCREMENTAL_SH, PHASE_ASSIGN_P2P, PHASE_NOTIFY_MAC, PHASE_LOGGING };
+
     protected:
         // Simulation signals
         simsignal_t scheduleSignal;
-        simsignal_t utilizationSignal;
+        simsignal_t utilizationSignal; // Share of SH slots with at least one transmitter, per frame
+        simsignal_t utilizationP2PSignal;
+        simsignal_t linkUtilizationP2PSignal; // Share of the maxP2PLinks links per slot in use, per P2P pass
+        simsignal_t spatialReuseSHSignal;
+        simsignal_t spatialReuseP2PSignal;
+        simsignal_t servedSHSignal;
+        simsignal_t servedP2PSignal;
+        simsignal_t backlogSHSignal;
+        simsignal_t backlogP2PSignal;
+        simsignal_t unassignedBacklogSHSignal;
+        simsignal_t unassignedBacklogP2PSignal;
         simsignal_t nodeIdSignal; // New signal declaration
 
         // Scheduler properties
         int numNodes = 0;
         int slotIndex = 0;
         int maxP2PLinks;
+        int p2pPlanningHorizonSlots; // Number of P2P slots planned per scheduling pass
+        int plannedSlotsP2P = 1; // Number of P2P slots planned by the last pass
+        int unplannedGlobalSlotP2P = 0; // First global slot not yet covered by a P2P pass
+        bool incrementalGrantsSH; // Grant free slots of the running frame to nodes whose SH buffer becomes non-empty
+        bool pullBufferStatus; // Read all queue lengths right before a pass instead of receiving a report per queue change
+        SchedulerCore core; // Graph build and SH/P2P policies, independent of the simulator
+        P2PReservationTable reservationsP2P; // Semi-persistent P2P links of steady flows, served before the policy runs
+
+        ChannelMetricsCounter metricsSH; // Slot usage of the latest SH frame including its mid-frame grants
+        ChannelMetricsCounter metricsP2P; // Slot usage of the latest P2P pass
+        PhaseTimers phaseTimers; // Wall time per phase, optionally written as a Chrome trace-event timeline to phaseTimelineFile
+        std::vector<cHistogram*> phaseHistograms; // Wall time per invocation of each phase
+
+        ScheduleTraceWriter scheduleTrace; // Binary record of every SH frame and P2P pass, open if scheduleTraceFile is set
+        ScheduleTraceReader scheduleReplay; // Streams the trace given by scheduleReplayFile
+        bool replaySchedule = false; // Grants come from scheduleReplay instead of the policies
+        ScheduleTrace::RecordType replayRecord = ScheduleTrace::END; // Type of the decoded record waiting to be replayed
 
         // Client information
-        std::map<int, AbstractLdacsTdmaMac*> clients;
-        std::map<int, inet::MacAddress> clientsMacAddress;
-        std::map<int, inet::IMobility*> mobilityModules;
-        map<int, int> bufferStatusSH;
-        map<int, int> bufferStatusP2P;
+        NodeTable nodes; // MAC, mobility, buffer status and last assignment of every registered node, indexed by node ID
 
         // Node and slot mapping
-        std::unordered_map<int, int> nodeMapping; // Node ID to index mapping
         std::unordered_map<int, int> localToGlobalSlotMappingSH; // Local to global slot ID mapping for SH schedule
 
         // Slot and frame configurations
-        std::vector<std::vector<int>> adjacencyMatrix;
         NodeToSlotsMap nodeToSlotsMapSH; // Assigned slots for each node in SH
         NodeToSlotsMap nodeToSlotsMapP2P; // Assigned slots for each node in P2P
+        std::unordered_map<int, std::vector<int>> linkRecipientsP2P; // Recipient of each slot in nodeToSlotsMapP2P
         SlotToNodesMap slotToNodesMapSH; // Assigned nodes for each slot in SH
         SlotToNodesMap slotToNodesMapP2P; // Assigned nodes for each slot in P2P
-        std::unordered_map<int, simtime_t> lastAssignedSH; // Last assignment time in SH
-        std::unordered_map<int, simtime_t> lastAssignedP2P; // Last assignment time in P2P
 
         // Timing and interval settings
         double frameDuration;
@@ -105,16 +136,29 @@ class AbstractLdacsTdmaScheduler: public cSimpleModule
         cMessage* schedulingP2PSelfMessage = nullptr;
         cMessage* slotSelfMessage = nullptr; // Message for slot scheduling
         cMessage* buildGraphMsg = nullptr; // Message to trigger graph building
+        cMessage* replayGrantSHSelfMessage = nullptr; // Message to replay a mid-frame SH grant at its recorded time
 
         // Initialization and message handling
         void initialize(int stage) override;
         virtual void handleMessage(cMessage *message) override;
+        virtual void finish() override;
 
         // Scheduler logic methods
         virtual void assignSlotsSH();
         virtual void assignSlotsP2P();
+        virtual void assignIncrementalSlotsSH(int nodeId); // Fits a newly backlogged node into conflict-free slots left in the running frame
+        void pullBufferStatusSH(); // Reads the SH queue length of every MAC
+        void pullBufferStatusP2P(); // Reads the P2P queue and per-destination lengths of every MAC
         void createScheduleSH();
         void createScheduleP2P();
+        void pushScheduleSH(); // Hands nodeToSlotsMapSH to the MACs
+        void pushScheduleP2P(); // Hands nodeToSlotsMapP2P and linkRecipientsP2P to the MACs
+        void advanceReplay(); // Decodes the next trace record, mid-frame grants are scheduled for their recorded time
+        void replayFrameSH();
+        void replayPassP2P();
+        void replayGrantSH();
+        void emitMetricsSH(); // Emits the metrics of the latest SH frame, called when the next frame is scheduled
+        void emitMetricsP2P();
         virtual void updateSlotTimeInfo();
         virtual void initializeSHAssignment(); // Initialize variables and structures for SH slot assignment.
         virtual void initializeP2PAssignment(); // Initialize variables and structures for P2P slot assignment.
@@ -130,22 +174,24 @@ class AbstractLdacsTdmaScheduler: public cSimpleModule
         double getNextSlotStartTime();
 
         // Helper functions
-        std::pair<std::vector<std::vector<int>>, std::unordered_map<int, int>> createAdjacencyMatrixAndNodeMapping();
         void buildGraph();
+        void printGraph(const std::vector<int>& activeNodes);
         std::vector<int> findNodesWithinOneAndTwoHops(int nodeId);
         std::string getHostName(int nodeId);
         SlotToNodesMap createSlotToNodesMap(const NodeToSlotsMap& nodeToSlotsMap);
         void printSlotAssignments(const SlotToNodesMap& slotToNodesMap);
         void printNodeSlotAssignments(const NodeToSlotsMap& nodeToSlotsMap);
-        void printBufferStatus(const std::map<int, int>& buffer);
+        void printBufferStatus(const std::vector<int>& buffer);
         int findLocalSlotIndex(int currentGlobalSlotIndex); // Find the corresponding local slot index for the current global slot index
-        std::unordered_set<int> populateAvailableNodesSH(double slotStart);
-        std::unordered_set<int> populateAvailableNodesP2P(double slotStart); // Populates the set of available nodes based on their eligibility and buffer status.
+        SchedulingSnapshotSH createSnapshotSH(); // Conflict sets, buffer status and eligibility handed to the SH policy for the next frame
+        SchedulingSnapshotP2P createSnapshotP2P(int localSlotIndex, double slotStartTime); // Candidate links and SH occupancy handed to the P2P policy for one slot
+        bool isEligibleForReassignmentSH(int nodeId, double slotStart); // Whether minReassignmentDurationSH has passed since the node's last SH slot
+        bool isEligibleForReassignmentP2P(int nodeId, double slotStart); // Whether minReassignmentDurationP2P has passed since the node's last P2P slot
         bool checkIfSlotExistsInSH(int nodeId, int localSlotIndex);  // Check if the the node have slots assigned in SH schedules.
-        bool checkIfSlotExistsInP2P(int nodeId, int globalSlotIndex);  // Check if the the node have slots assigned in P2P schedules.
+        void assignLinkP2P(int transmitter, int recipient, int globalSlotIndex, double slotStartTime); // Grants one P2P slot and accounts for the scheduled packet
+        int assignReservedLinksP2P(int globalSlotIndex, int localSlotIndex, double slotStartTime, std::vector<int>& reservedNodes); // Serves the reservations due in the slot, returns the number of links
+        bool isInRangeP2P(int transmitter, int recipient); // Whether both nodes are neighbours in the current connectivity graph
         int findNodeIdByMac(MacAddress macAddress); // Retrieve the node ID from its MAC address 
-        int selectRandomNode(const std::unordered_set<int>& availableNodes); // Takes a set of available node IDs and returns one of them selected at random.
-        int countAssignmentsForSlot(const std::unordered_map<int, std::vector<int>>& map, int slotID);
 
     public:
         // Constructor and destructor
@@ -156,6 +202,14 @@ class AbstractLdacsTdmaScheduler: public cSimpleModule
         int registerClient(AbstractLdacsTdmaMac *mac, int statusSH, int statusP2P, inet::IMobility *mobilityModule, inet::MacAddress macAddress);
         void reportBufferStatusSH(int nodeId, int bufferStatus);
         void reportBufferStatusP2P(int nodeId, int bufferStatus);
+        void reportBufferStatusP2P(int nodeId, const MacAddress& destination, int bufferStatus); // Backlog of one virtual output queue
+        bool pullsBufferStatus() const { return pullBufferStatus; } // MACs skip their reports if the scheduler pulls
+
+        // Random numbers for the scheduling policies, drawn from the module's RNG stream
+        int uniformInt(int low, int high) override;
+
+        // Collects the per-invocation wall time of the phase timers
+        void phaseCompleted(int phase, double seconds) override;
 
         // Transmission time recording
         void recordTransmissionTimeSH(int nodeId, simtime_t transmissionTimeSH);
@@ -0,0 +1,52 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CandidatePool.h"
+
+void CandidatePool::reset(int capacity) {
+    // Only the previously present items need their position cleared
+    for (int item : items) {
+        positions[item] = -1;
+    }
+    items.clear();
+    positions.resize(capacity, -1);
+}
+
+void CandidatePool::insert(int item) {
+    if (contains(item)) {
+        return;
+    }
+    positions[item] = (int)items.size();
+    items.push_back(item);
+}
+
+bool CandidatePool::remove(int item) {
+    if (!contains(item)) {
+        return false;
+    }
+    takeAt(positions[item]);
+    return true;
+}
+
+int CandidatePool::takeAt(int i) {
+    int item = items[i];
+    int last = items.back();
+    items[i] = last;
+    positions[last] = i;
+    items.pop_back();
+    positions[item] = -1;
+    return item;
+}
@@ -0,0 +1,48 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_CANDIDATE_POOL_H
+#define __INET_CANDIDATE_POOL_H
+
+#include <vector>
+
+/** @brief Dense set of small non-negative integers (node IDs or graph indices).
+ *
+ * Items are kept in a plain vector plus a reverse position index, so picking the
+ * i-th item, inserting and removing an arbitrary item are all O(1). Removal swaps
+ * the item with the last one and pops, hence the item order is not stable.
+ */
+class CandidatePool
+{
+    public:
+        void reset(int capacity); // Removes all items and allows IDs in [0, capacity)
+
+        int size() const { return (int)items.size(); }
+        bool empty() const { return items.empty(); }
+        int at(int i) const { return items[i]; }
+        const std::vector<int>& getItems() const { return items; }
+
+        bool contains(int item) const { return item >= 0 && item < (int)positions.size() && positions[item] >= 0; }
+        void insert(int item);
+        bool remove(int item);
+        int takeAt(int i); // Removes and returns the i-th item
+
+    protected:
+        std::vector<int> items;
+        std::vector<int> positions; // Index of each item in items, -1 if absent
+};
+
+#endif
@@ -0,0 +1,78 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ConflictSets.h"
+#include "ParallelFor.h"
+
+void ConflictSets::clear() {
+    numNodes = 0;
+    numWords = 0;
+    words.clear();
+}
+
+void ConflictSets::build(const ConnectivityGraph& graph, int numThreads) {
+    numNodes = graph.getNumVertices();
+    numWords = NodeBitset::numWordsFor(numNodes);
+    words.assign((size_t)numNodes * numWords, 0);
+
+    // 1-hop rows including the node itself, so that a neighbour's row covers it and its neighbours
+    std::vector<uint64_t> closedNeighbourhoods((size_t)numNodes * numWords, 0);
+    for (int u = 0; u < numNodes; ++u) {
+        uint64_t *row = closedNeighbourhoods.data() + (size_t)u * numWords;
+        row[u >> 6] |= uint64_t(1) << (u & 63);
+        for (int neighbour : graph.getNeighbours(u)) {
+            row[neighbour >> 6] |= uint64_t(1) << (neighbour & 63);
+        }
+    }
+
+    // Each thread only writes the rows of its own block of nodes
+    parallelFor(numNodes, numThreads, [&](int, int begin, int end) {
+        buildRows(graph, closedNeighbourhoods, begin, end);
+    });
+}
+
+void ConflictSets::buildRows(const ConnectivityGraph& graph, const std::vector<uint64_t>& closedNeighbourhoods, int begin, int end) {
+    for (int v = begin; v < end; ++v) {
+        uint64_t *__restrict row = words.data() + (size_t)v * numWords;
+        for (int neighbour : graph.getNeighbours(v)) {
+            if (graph.getDegree(neighbour) < numWords) {
+                // Sparse neighbour, setting its few bits is cheaper than a full row
+                row[neighbour >> 6] |= uint64_t(1) << (neighbour & 63);
+                for (int twoHopNeighbour : graph.getNeighbours(neighbour)) {
+                    row[twoHopNeighbour >> 6] |= uint64_t(1) << (twoHopNeighbour & 63);
+                }
+            }
+            else {
+                // Dense neighbour, word-wise OR of its closed neighbourhood
+                const uint64_t *__restrict neighbourRow = closedNeighbourhoods.data() + (size_t)neighbour * numWords;
+                for (int w = 0; w < numWords; ++w) {
+                    row[w] |= neighbourRow[w];
+                }
+            }
+        }
+        // The 2-hop walk leads back to v through every neighbour
+        row[v >> 6] &= ~(uint64_t(1) << (v & 63));
+    }
+}
+
+int ConflictSets::getNumConflicts(int node) const {
+    const uint64_t *row = getRow(node);
+    int total = 0;
+    for (int w = 0; w < numWords; ++w) {
+        total += __builtin_popcountll(row[w]);
+    }
+    return total;
+}
@@ -0,0 +1,52 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_CONFLICT_SETS_H
+#define __INET_CONFLICT_SETS_H
+
+#include "ConnectivityGraph.h"
+#include "NodeBitset.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** @brief Per-node 1-hop and 2-hop neighbourhoods as packed bitset rows.
+ *
+ * Row v holds every graph index within two hops of v, excluding v itself, i.e.
+ * the nodes that must not transmit in the same SH slot as v. The rows are
+ * computed once per graph build and stored back to back in one array.
+ */
+class ConflictSets
+{
+    public:
+        void clear();
+        void build(const ConnectivityGraph& graph, int numThreads = 1); // Rows are independent and split over numThreads threads
+
+        int getNumNodes() const { return numNodes; }
+        int getNumWords() const { return numWords; }
+        const uint64_t *getRow(int node) const { return words.data() + (size_t)node * numWords; }
+        bool conflicts(int u, int v) const { return (getRow(u)[v >> 6] >> (v & 63)) & 1; }
+        int getNumConflicts(int node) const; // Size of the 2-hop neighbourhood of the node
+
+    protected:
+        int numNodes = 0;
+        int numWords = 0;
+        std::vector<uint64_t> words;
+
+        void buildRows(const ConnectivityGraph& graph, const std::vector<uint64_t>& closedNeighbourhoods, int begin, int end);
+};
+
+#endif
@@ -0,0 +1,58 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ConnectivityGraph.h"
+#include <algorithm>
+
+void ConnectivityGraph::clear() {
+    offsets.clear();
+    neighbours.clear();
+}
+
+void ConnectivityGraph::build(int numVertices, const std::vector<std::pair<int, int>>& edges) {
+    // Count the degree of every vertex, shifted by one for the prefix sum
+    offsets.assign(numVertices + 1, 0);
+    for (const auto& edge : edges) {
+        ++offsets[edge.first + 1];
+        ++offsets[edge.second + 1];
+    }
+    for (int v = 0; v < numVertices; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    // Scatter both directions of every edge into the neighbour array
+    neighbours.resize(offsets[numVertices]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& edge : edges) {
+        neighbours[fill[edge.first]++] = edge.second;
+        neighbours[fill[edge.second]++] = edge.first;
+    }
+
+    // Sorted lists make the layout independent of the edge order and allow binary search
+    for (int v = 0; v < numVertices; ++v) {
+        std::sort(neighbours.begin() + offsets[v], neighbours.begin() + offsets[v + 1]);
+    }
+}
+
+ConnectivityGraph::NeighbourRange ConnectivityGraph::getNeighbours(int vertex) const {
+    const int *data = neighbours.data();
+    return NeighbourRange(data + offsets[vertex], data + offsets[vertex + 1]);
+}
+
+bool ConnectivityGraph::isConnected(int u, int v) const {
+    NeighbourRange range = getNeighbours(u);
+    return std::binary_search(range.begin(), range.end(), v);
+}
@@ -0,0 +1,63 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_CONNECTIVITY_GRAPH_H
+#define __INET_CONNECTIVITY_GRAPH_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/** @brief Undirected connectivity graph in compressed sparse row (CSR) form.
+ *
+ * The neighbours of vertex v are stored contiguously and sorted in
+ * neighbours[offsets[v] .. offsets[v + 1]), so memory scales with the number
+ * of edges and neighbour queries only touch the actual neighbours.
+ */
+class ConnectivityGraph
+{
+    public:
+        /** @brief Contiguous, read-only view on the neighbour list of one vertex. */
+        class NeighbourRange
+        {
+            public:
+                NeighbourRange(const int *first, const int *last) : first(first), last(last) {}
+                const int *begin() const { return first; }
+                const int *end() const { return last; }
+                int size() const { return (int)(last - first); }
+                bool empty() const { return first == last; }
+
+            protected:
+                const int *first;
+                const int *last;
+        };
+
+        void clear();
+        // Builds the CSR arrays from a list of undirected edges (each pair given once)
+        void build(int numVertices, const std::vector<std::pair<int, int>>& edges);
+
+        int getNumVertices() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+        int getNumEdges() const { return (int)neighbours.size() / 2; }
+        int getDegree(int vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+        NeighbourRange getNeighbours(int vertex) const;
+        bool isConnected(int u, int v) const; // Binary search in the sorted neighbour list of u
+
+    protected:
+        std::vector<int> offsets;    // Size numVertices + 1, start of each neighbour list
+        std::vector<int> neighbours; // Size 2 * numEdges, concatenated neighbour lists
+};
+
+#endif
@@ -0,0 +1,223 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "GreedySlotColouring.h"
+
+bool GreedySlotColouring::Candidate::operator<(const Candidate& other) const {
+    if (priority != other.priority) {
+        return priority < other.priority;
+    }
+    if (degree != other.degree) {
+        return degree > other.degree;
+    }
+    return node > other.node; // Lower index first for deterministic results
+}
+
+GreedySlotColouring::Candidate GreedySlotColouring::makeCandidate(int node) const {
+    return Candidate{(double)state.getRemaining(node) / (degree[node] + 1), degree[node], node};
+}
+
+void GreedySlotColouring::CandidateHeap::reset(int numNodes) {
+    entries.clear();
+    positions.assign(numNodes, -1);
+    removed.assign(numNodes, false);
+    numRemoved = 0;
+}
+
+void GreedySlotColouring::CandidateHeap::clear() {
+    for (const Candidate& entry : entries) {
+        positions[entry.node] = -1;
+        removed[entry.node] = false;
+    }
+    entries.clear();
+    numRemoved = 0;
+}
+
+void GreedySlotColouring::CandidateHeap::push(const Candidate& candidate) {
+    entries.push_back(candidate);
+    siftUp((int)entries.size() - 1, candidate);
+}
+
+GreedySlotColouring::Candidate GreedySlotColouring::CandidateHeap::pop() {
+    while (true) {
+        Candidate top = popTop();
+        if (!removed[top.node]) {
+            return top;
+        }
+        removed[top.node] = false;
+        --numRemoved;
+    }
+}
+
+GreedySlotColouring::Candidate GreedySlotColouring::CandidateHeap::popTop() {
+    Candidate top = entries.front();
+    Candidate last = entries.back();
+    entries.pop_back();
+    positions[top.node] = -1;
+    if (!entries.empty()) {
+        siftDown(0, last);
+    }
+    return top;
+}
+
+void GreedySlotColouring::CandidateHeap::remove(int node) {
+    if (positions[node] == -1 || removed[node]) {
+        return;
+    }
+    removed[node] = true;
+    if (++numRemoved * 2 > (int)entries.size()) {
+        purge();
+    }
+}
+
+void GreedySlotColouring::CandidateHeap::purge() {
+    int size = 0;
+    for (const Candidate& entry : entries) {
+        if (removed[entry.node]) {
+            positions[entry.node] = -1;
+            removed[entry.node] = false;
+        }
+        else {
+            place(size++, entry);
+        }
+    }
+    entries.resize(size);
+    numRemoved = 0;
+    // Bottom-up heap construction, linear in the number of remaining entries
+    for (int position = size / 2 - 1; position >= 0; --position) {
+        siftDown(position, entries[position]);
+    }
+}
+
+void GreedySlotColouring::CandidateHeap::increase(const Candidate& candidate) {
+    int position = positions[candidate.node];
+    if (position != -1) {
+        siftUp(position, candidate);
+    }
+}
+
+void GreedySlotColouring::CandidateHeap::siftUp(int position, Candidate candidate) {
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (!(entries[parent] < candidate)) {
+            break;
+        }
+        place(position, entries[parent]);
+        position = parent;
+    }
+    place(position, candidate);
+}
+
+void GreedySlotColouring::CandidateHeap::siftDown(int position, Candidate candidate) {
+    int size = (int)entries.size();
+    while (true) {
+        int child = 2 * position + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && entries[child] < entries[child + 1]) {
+            ++child;
+        }
+        if (!(candidate < entries[child])) {
+            break;
+        }
+        place(position, entries[child]);
+        position = child;
+    }
+    place(position, candidate);
+}
+
+void GreedySlotColouring::assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource&, std::vector<std::vector<int>>& nodeSlots) {
+    state.reset(snapshot, nodeSlots);
+    degree.assign(snapshot.conflicts->getNumNodes(), 0);
+    queue.reset(snapshot.conflicts->getNumNodes());
+    collectConflicts(snapshot);
+    for (int slot = 0; slot < snapshot.numSlots; ++slot) {
+        assignSlot(slot, nodeSlots);
+    }
+}
+
+void GreedySlotColouring::collectConflicts(const SchedulingSnapshotSH& snapshot) {
+    const ConflictSets& conflicts = *snapshot.conflicts;
+    int numNodes = conflicts.getNumNodes();
+    int numWords = conflicts.getNumWords();
+    NodeBitset backlogged;
+    backlogged.resize(numNodes);
+    for (int v = 0; v < numNodes; ++v) {
+        if (snapshot.bufferStatus[v] > 0) {
+            backlogged.set(v);
+        }
+    }
+    // The full rows are read once per frame, the slots then only walk the short lists
+    conflictOffsets.assign(numNodes + 1, 0);
+    conflictNodes.clear();
+    for (int v = 0; v < numNodes; ++v) {
+        if (backlogged.test(v)) {
+            const uint64_t *row = conflicts.getRow(v);
+            for (int w = 0; w < numWords; ++w) {
+                uint64_t bits = row[w] & backlogged.data()[w];
+                while (bits) {
+                    conflictNodes.push_back(w * 64 + __builtin_ctzll(bits));
+                    bits &= bits - 1;
+                }
+            }
+        }
+        conflictOffsets[v + 1] = (int)conflictNodes.size();
+    }
+}
+
+void GreedySlotColouring::assignSlot(int slot, std::vector<std::vector<int>>& nodeSlots) {
+    state.collectCandidates(slot, candidates);
+    queue.clear();
+
+    // All degrees are known before the heap is filled
+    candidates.forEachSetBit([&](int v) {
+        int count = 0;
+        for (int i = conflictOffsets[v]; i < conflictOffsets[v + 1]; ++i) {
+            count += candidates.test(conflictNodes[i]);
+        }
+        degree[v] = count;
+    });
+    candidates.forEachSetBit([&](int v) {
+        queue.push(makeCandidate(v));
+    });
+
+    while (!queue.empty()) {
+        int v = queue.pop().node;
+        state.assign(v, slot, nodeSlots);
+        candidates.reset(v);
+
+        // Drop the conflicting candidates, then lower the degree of the candidates they conflicted with
+        dropped.clear();
+        for (int i = conflictOffsets[v]; i < conflictOffsets[v + 1]; ++i) {
+            int u = conflictNodes[i];
+            if (candidates.test(u)) {
+                dropped.push_back(u);
+                candidates.reset(u);
+                queue.remove(u);
+            }
+        }
+        for (int u : dropped) {
+            for (int i = conflictOffsets[u]; i < conflictOffsets[u + 1]; ++i) {
+                int x = conflictNodes[i];
+                if (candidates.test(x)) {
+                    --degree[x];
+                    queue.increase(makeCandidate(x));
+                }
+            }
+        }
+    }
+}
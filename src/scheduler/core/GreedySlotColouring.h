@@ -0,0 +1,90 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_GREEDY_SLOT_COLOURING_H
+#define __INET_GREEDY_SLOT_COLOURING_H
+
+#include "SchedulingPolicy.h"
+#include <vector>
+
+/** @brief SH slot assignment as backlog-weighted greedy colouring of the 2-hop conflict graph.
+ *
+ * Slots are colours and each slot's colour class is built on its own: among the
+ * nodes that still have backlog and may use the slot, the node with the largest
+ * backlog / (conflicting candidates + 1) is taken and its conflicting nodes are
+ * dropped, until no candidate is left. Preferring nodes that block few others
+ * packs more concurrent transmitters into a slot than a uniform random pick, and
+ * the backlog weight keeps nodes in dense areas from being starved.
+ */
+class GreedySlotColouring: public ISchedulingPolicySH
+{
+    public:
+        void assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource&, std::vector<std::vector<int>>& nodeSlots) override;
+
+    protected:
+        struct Candidate
+        {
+            double priority; // Remaining demand / (conflicting candidates + 1)
+            int degree;
+            int node;
+            bool operator<(const Candidate& other) const; // Heap order, highest priority on top
+        };
+
+        /** @brief Binary max-heap of candidates with one entry per node.
+         *
+         * A degree decrement only raises a node's priority, so its entry is updated
+         * and sifted up in place instead of pushing another one. Removed entries are
+         * only marked and purged in bulk once they make up half of the heap, which
+         * is cheaper than sifting each one out as most candidates are dropped.
+         */
+        class CandidateHeap
+        {
+            public:
+                void reset(int numNodes);
+                void clear();
+                bool empty() const { return (int)entries.size() == numRemoved; }
+                void push(const Candidate& candidate);
+                Candidate pop(); // Highest priority entry that was not removed
+                void increase(const Candidate& candidate); // Replaces the node's entry by one of higher priority
+                void remove(int node);
+
+            protected:
+                std::vector<Candidate> entries;
+                std::vector<int> positions; // Index of each node's entry, -1 if absent
+                std::vector<bool> removed; // Entry is still in the heap but no longer a candidate
+                int numRemoved = 0;
+
+                void place(int position, const Candidate& candidate) { entries[position] = candidate; positions[candidate.node] = position; }
+                Candidate popTop();
+                void purge(); // Drops the removed entries and restores the heap order
+                void siftUp(int position, Candidate candidate);
+                void siftDown(int position, Candidate candidate);
+        };
+
+        FrameStateSH state;
+        NodeBitset candidates; // Nodes that may still be added to the slot being built
+        std::vector<int> degree; // Conflicting nodes among the current candidates
+        std::vector<int> dropped; // Scratch list of conflicting nodes removed with a selection
+        std::vector<int> conflictOffsets; // Conflicting backlogged nodes of node v are conflictNodes[conflictOffsets[v], conflictOffsets[v + 1])
+        std::vector<int> conflictNodes;
+        CandidateHeap queue;
+
+        Candidate makeCandidate(int node) const;
+        void collectConflicts(const SchedulingSnapshotSH& snapshot); // Sparse conflict lists among the backlogged nodes, ascending
+        void assignSlot(int slot, std::vector<std::vector<int>>& nodeSlots);
+};
+
+#endif
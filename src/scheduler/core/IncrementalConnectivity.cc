@@ -0,0 +1,125 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "IncrementalConnectivity.h"
+
+void IncrementalConnectivity::configure(double communicationRange, double displacementSlack) {
+    range = communicationRange;
+    slack = displacementSlack > 0 ? displacementSlack : 0;
+    anchorGrid.setCellSize(range + slack);
+    clear();
+}
+
+void IncrementalConnectivity::clear() {
+    anchorGrid.clear();
+    tracked.clear();
+    anchors.clear();
+    candidates.clear();
+    graphIndex.clear();
+    trackedNodes.clear();
+}
+
+void IncrementalConnectivity::update(const std::vector<int>& activeNodeIds, const std::vector<NodePosition>& positions,
+                                     std::vector<std::pair<int, int>>& edges) {
+    numSearches = 0;
+
+    // Map the active node IDs to their index in this build; stale entries are reset below
+    for (int i = 0; i < (int)activeNodeIds.size(); ++i) {
+        ensureCapacity(activeNodeIds[i]);
+        graphIndex[activeNodeIds[i]] = i;
+    }
+
+    // Drop nodes whose SH buffer ran empty since the last update
+    std::vector<int> stillTracked;
+    stillTracked.reserve(trackedNodes.size());
+    for (int nodeId : trackedNodes) {
+        int index = graphIndex[nodeId];
+        if (index >= 0 && index < (int)activeNodeIds.size() && activeNodeIds[index] == nodeId) {
+            stillTracked.push_back(nodeId);
+        }
+        else {
+            detach(nodeId);
+            tracked[nodeId] = false;
+            graphIndex[nodeId] = -1;
+        }
+    }
+    trackedNodes = std::move(stillTracked);
+
+    // Add newly backlogged nodes and re-anchor the ones that moved too far
+    double maxDisplacement = slack / 2;
+    for (int i = 0; i < (int)activeNodeIds.size(); ++i) {
+        int nodeId = activeNodeIds[i];
+        if (!tracked[nodeId]) {
+            tracked[nodeId] = true;
+            trackedNodes.push_back(nodeId);
+            attach(nodeId, positions[i]);
+        }
+        else if (positions[i].distance(anchors[nodeId]) > maxDisplacement) {
+            detach(nodeId);
+            attach(nodeId, positions[i]);
+        }
+    }
+
+    // Exact range check on candidate pairs yields the same edges as a full rebuild
+    for (int i = 0; i < (int)activeNodeIds.size(); ++i) {
+        for (int candidate : candidates[activeNodeIds[i]]) {
+            int j = graphIndex[candidate];
+            if (j > i && positions[i].distance(positions[j]) <= range) {
+                edges.emplace_back(i, j);
+            }
+        }
+    }
+}
+
+void IncrementalConnectivity::ensureCapacity(int nodeId) {
+    if (nodeId >= (int)tracked.size()) {
+        tracked.resize(nodeId + 1, false);
+        anchors.resize(nodeId + 1);
+        candidates.resize(nodeId + 1);
+        graphIndex.resize(nodeId + 1, -1);
+    }
+}
+
+void IncrementalConnectivity::detach(int nodeId) {
+    anchorGrid.remove(nodeId, anchors[nodeId]);
+    for (int candidate : candidates[nodeId]) {
+        eraseCandidate(candidates[candidate], nodeId);
+    }
+    candidates[nodeId].clear();
+}
+
+void IncrementalConnectivity::attach(int nodeId, const NodePosition& position) {
+    ++numSearches;
+    anchors[nodeId] = position;
+    double candidateRange = range + slack;
+    anchorGrid.forEachCandidate(position, [&](int other) {
+        if (anchors[other].distance(position) <= candidateRange) {
+            candidates[nodeId].push_back(other);
+            candidates[other].push_back(nodeId);
+        }
+    });
+    anchorGrid.insert(nodeId, position);
+}
+
+void IncrementalConnectivity::eraseCandidate(std::vector<int>& list, int nodeId) {
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (list[i] == nodeId) {
+            list[i] = list.back();
+            list.pop_back();
+            return;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_INCREMENTAL_CONNECTIVITY_H
+#define __INET_INCREMENTAL_CONNECTIVITY_H
+
+#include "SpatialGrid.h"
+#include <utility>
+#include <vector>
+
+/** @brief Keeps candidate neighbour lists up to date across graph rebuilds.
+ *
+ * Every tracked node has an anchor position, taken when its candidates were
+ * last searched. Two nodes are candidates of each other while their anchors
+ * are at most range + slack apart. As long as no node has moved more than
+ * slack / 2 away from its anchor, every pair within range is a candidate pair,
+ * so the exact edge set follows from distance-testing candidates only. Only
+ * nodes that were added or have moved beyond slack / 2 are searched again in
+ * the spatial grid, which makes the search cost proportional to churn.
+ */
+class IncrementalConnectivity
+{
+    public:
+        void configure(double range, double slack);
+        void clear();
+
+        // Synchronises the tracked nodes with the given active nodes and their current
+        // positions, then appends all edges within range as pairs of indices into activeNodeIds.
+        void update(const std::vector<int>& activeNodeIds, const std::vector<NodePosition>& positions,
+                    std::vector<std::pair<int, int>>& edges);
+
+        int getNumSearches() const { return numSearches; } // Candidate searches during the last update
+
+    protected:
+        double range = 0;
+        double slack = 0;
+        SpatialGrid anchorGrid; // Anchors of all tracked nodes, cell size range + slack
+
+        // Indexed by node ID
+        std::vector<bool> tracked;
+        std::vector<NodePosition> anchors;
+        std::vector<std::vector<int>> candidates;
+        std::vector<int> graphIndex; // Index of the node in the current activeNodeIds, -1 if inactive
+        std::vector<int> trackedNodes; // IDs of all tracked nodes
+
+        int numSearches = 0;
+
+        void ensureCapacity(int nodeId);
+        void detach(int nodeId); // Removes the node from the grid and from all candidate lists
+        void attach(int nodeId, const NodePosition& position); // Anchors the node and searches its candidates
+        static void eraseCandidate(std::vector<int>& list, int nodeId);
+};
+
+#endif
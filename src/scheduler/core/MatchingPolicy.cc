@@ -0,0 +1,85 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MatchingPolicy.h"
+#include <algorithm>
+
+int MatchingPolicyP2P::addVertex(int nodeId) {
+    if (vertexOf[nodeId] == -1) {
+        vertexOf[nodeId] = (int)nodeOf.size();
+        nodeOf.push_back(nodeId);
+    }
+    return vertexOf[nodeId];
+}
+
+void MatchingPolicyP2P::assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource&, std::vector<P2PLink>& links) {
+    links.clear();
+    state.reset(snapshot);
+    vertexOf.assign(snapshot.busySH.size(), -1);
+    nodeOf.clear();
+
+    // Only nodes with a feasible demand enter the matching graph
+    std::vector<std::pair<int, int>> edges;
+    for (int transmitter : snapshot.candidates) {
+        for (const P2PDemand& demand : snapshot.demands[transmitter]) {
+            if (state.isFeasible(snapshot, transmitter, demand.recipient)) {
+                edges.push_back(std::make_pair(addVertex(transmitter), addVertex(demand.recipient)));
+            }
+        }
+    }
+    matching.reset((int)nodeOf.size());
+    for (const auto& edge : edges) {
+        matching.addEdge(edge.first, edge.second);
+    }
+    matching.solve();
+
+    // Orient every matched pair; if both ends want to send to each other the larger backlog transmits
+    std::vector<P2PLink> matched;
+    std::vector<int> backlogs;
+    for (int v = 0; v < matching.getNumVertices(); ++v) {
+        int u = matching.getMate(v);
+        if (u < v) {
+            continue; // Unmatched, or the pair was handled from the other end
+        }
+        int a = nodeOf[v];
+        int b = nodeOf[u];
+        int backlogAB = findBacklog(snapshot, a, b);
+        int backlogBA = findBacklog(snapshot, b, a);
+        matched.push_back(backlogBA > backlogAB ? P2PLink{b, a} : P2PLink{a, b});
+        backlogs.push_back(std::max(backlogAB, backlogBA));
+    }
+
+    std::vector<int> order(matched.size());
+    for (int i = 0; i < (int)order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return backlogs[a] > backlogs[b]; });
+    if ((int)order.size() > snapshot.maxLinks) {
+        order.resize(std::max(0, snapshot.maxLinks));
+    }
+    for (int i : order) {
+        state.assign(matched[i].transmitter, matched[i].recipient, links);
+    }
+}
+
+int MatchingPolicyP2P::findBacklog(const SchedulingSnapshotP2P& snapshot, int transmitter, int recipient) const {
+    for (const P2PDemand& demand : snapshot.demands[transmitter]) {
+        if (demand.recipient == recipient) {
+            return demand.backlog;
+        }
+    }
+    return -1;
+}
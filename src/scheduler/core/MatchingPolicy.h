@@ -0,0 +1,45 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_MATCHING_POLICY_H
+#define __INET_MATCHING_POLICY_H
+
+#include "MaximumMatching.h"
+#include "SchedulingPolicy.h"
+
+/** @brief P2P assignment as maximum matching of the pending transmitter->recipient demands.
+ *
+ * Every feasible demand, i.e. neither end busy on the SH channel, becomes an
+ * edge between transmitter and recipient. A maximum matching uses every node in
+ * at most one link and has the largest number of links any such assignment can
+ * have. If it exceeds maxLinks, the links with the largest backlog are kept.
+ */
+class MatchingPolicyP2P: public ISchedulingPolicyP2P
+{
+    public:
+        void assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links) override;
+
+    protected:
+        MaximumMatching matching;
+        std::vector<int> vertexOf; // Node ID to matching vertex, -1 if the node has no feasible demand
+        std::vector<int> nodeOf; // Matching vertex to node ID
+        SlotStateP2P state;
+
+        int addVertex(int nodeId);
+        int findBacklog(const SchedulingSnapshotP2P& snapshot, int transmitter, int recipient) const; // -1 if there is no such demand
+};
+
+#endif
@@ -0,0 +1,59 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MaxWeightPolicy.h"
+#include <algorithm>
+
+void MaxWeightPolicySH::assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource&, std::vector<std::vector<int>>& nodeSlots) {
+    state.reset(snapshot, nodeSlots);
+    for (int slot = 0; slot < snapshot.numSlots; ++slot) {
+        state.collectCandidates(slot, availableNodes);
+        order.clear();
+        availableNodes.forEachSetBit([&](int index) { order.push_back(index); });
+        // Ties keep the ascending graph index order
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return state.getRemaining(a) > state.getRemaining(b); });
+
+        for (int index : order) {
+            if (!availableNodes.test(index)) {
+                continue;
+            }
+            state.assign(index, slot, nodeSlots);
+            availableNodes.reset(index);
+            availableNodes.andNot(snapshot.conflicts->getRow(index));
+        }
+    }
+}
+
+void MaxWeightPolicyP2P::assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource&, std::vector<P2PLink>& links) {
+    links.clear();
+    state.reset(snapshot);
+    order.clear();
+    for (int transmitter : snapshot.candidates) {
+        for (const P2PDemand& demand : snapshot.demands[transmitter]) {
+            order.push_back(WeightedLink{transmitter, demand.recipient, demand.backlog});
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [](const WeightedLink& a, const WeightedLink& b) { return a.backlog > b.backlog; });
+
+    for (const WeightedLink& link : order) {
+        if ((int)links.size() >= snapshot.maxLinks) {
+            break;
+        }
+        if (state.isFeasible(snapshot, link.transmitter, link.recipient)) {
+            state.assign(link.transmitter, link.recipient, links);
+        }
+    }
+}
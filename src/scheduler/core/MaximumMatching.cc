@@ -0,0 +1,205 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MaximumMatching.h"
+#include <algorithm>
+#include <queue>
+
+void MaximumMatching::reset(int numVertices) {
+    adjacency.assign(numVertices, std::vector<int>());
+    mate.assign(numVertices, -1);
+    parent.assign(numVertices, -1);
+    base.resize(numVertices);
+    inTree.assign(numVertices, false);
+    inBlossom.assign(numVertices, false);
+    pruned.assign(numVertices, false);
+    visitStamp.assign(numVertices, 0);
+    lcaStamp.assign(numVertices, 0);
+    searchStamp = 0;
+    lcaCounter = 0;
+}
+
+void MaximumMatching::addEdge(int u, int v) {
+    if (u == v) {
+        return;
+    }
+    adjacency[u].push_back(v);
+    adjacency[v].push_back(u);
+}
+
+void MaximumMatching::solve() {
+    matchGreedily();
+    // A vertex without an augmenting path keeps having none after later augmentations, so one try per vertex suffices
+    for (int root = 0; root < getNumVertices(); ++root) {
+        if (mate[root] == -1 && !adjacency[root].empty()) {
+            int end = findAugmentingPath(root);
+            if (end != -1) {
+                augment(end);
+            } else {
+                pruneSearchTree();
+            }
+        }
+    }
+}
+
+void MaximumMatching::matchGreedily() {
+    // Always match a vertex with the fewest unmatched neighbours left, it has the fewest chances to be matched later
+    std::vector<int> degree(getNumVertices());
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> queue;
+    for (int v = 0; v < getNumVertices(); ++v) {
+        degree[v] = (int)adjacency[v].size();
+        queue.push(std::make_pair(degree[v], v));
+    }
+    auto removeFromGraph = [&](int v) {
+        for (int u : adjacency[v]) {
+            if (mate[u] == -1) {
+                queue.push(std::make_pair(--degree[u], u));
+            }
+        }
+    };
+    while (!queue.empty()) {
+        int v = queue.top().second;
+        int queuedDegree = queue.top().first;
+        queue.pop();
+        if (mate[v] != -1 || queuedDegree != degree[v] || degree[v] == 0) {
+            continue;
+        }
+        int best = -1;
+        for (int u : adjacency[v]) {
+            if (mate[u] == -1 && u != v && (best == -1 || degree[u] < degree[best])) {
+                best = u;
+            }
+        }
+        if (best == -1) {
+            continue;
+        }
+        mate[v] = best;
+        mate[best] = v;
+        removeFromGraph(v);
+        removeFromGraph(best);
+    }
+}
+
+void MaximumMatching::visit(int v) {
+    if (visitStamp[v] == searchStamp) {
+        return;
+    }
+    visitStamp[v] = searchStamp;
+    parent[v] = -1;
+    base[v] = v;
+    inTree[v] = false;
+    visited.push_back(v);
+}
+
+int MaximumMatching::findAugmentingPath(int root) {
+    ++searchStamp;
+    visited.clear();
+    queue.clear();
+    visit(root);
+    inTree[root] = true;
+    queue.push_back(root);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int v = queue[head];
+        for (int to : adjacency[v]) {
+            if (pruned[to]) {
+                continue;
+            }
+            visit(to);
+            if (base[v] == base[to] || mate[v] == to) {
+                continue;
+            }
+            bool mateInTree = mate[to] != -1 && visitStamp[mate[to]] == searchStamp && parent[mate[to]] != -1;
+            if (to == root || mateInTree) {
+                // Odd cycle: contract the blossom into its base
+                int blossomBase = findCommonBase(v, to);
+                for (int u : visited) {
+                    inBlossom[u] = false;
+                }
+                markBlossomPath(v, blossomBase, to);
+                markBlossomPath(to, blossomBase, v);
+                for (int u : visited) {
+                    if (inBlossom[base[u]]) {
+                        base[u] = blossomBase;
+                        if (!inTree[u]) {
+                            inTree[u] = true;
+                            queue.push_back(u);
+                        }
+                    }
+                }
+            }
+            else if (parent[to] == -1) {
+                parent[to] = v;
+                if (mate[to] == -1) {
+                    return to;
+                }
+                int next = mate[to];
+                visit(next);
+                inTree[next] = true;
+                queue.push_back(next);
+            }
+        }
+    }
+    return -1;
+}
+
+int MaximumMatching::findCommonBase(int a, int b) {
+    ++lcaCounter;
+    while (true) {
+        a = base[a];
+        lcaStamp[a] = lcaCounter;
+        if (mate[a] == -1) {
+            break;
+        }
+        a = parent[mate[a]];
+    }
+    while (true) {
+        b = base[b];
+        if (lcaStamp[b] == lcaCounter) {
+            return b;
+        }
+        b = parent[mate[b]];
+    }
+}
+
+void MaximumMatching::markBlossomPath(int v, int blossomBase, int child) {
+    while (base[v] != blossomBase) {
+        inBlossom[base[v]] = true;
+        inBlossom[base[mate[v]]] = true;
+        parent[v] = child;
+        child = mate[v];
+        v = parent[mate[v]];
+    }
+}
+
+void MaximumMatching::pruneSearchTree() {
+    for (int v : visited) {
+        if (inTree[v] || parent[v] != -1) {
+            pruned[v] = true;
+        }
+    }
+}
+
+void MaximumMatching::augment(int end) {
+    int v = end;
+    while (v != -1) {
+        int previous = parent[v];
+        int next = mate[previous];
+        mate[v] = previous;
+        mate[previous] = v;
+        v = next;
+    }
+}
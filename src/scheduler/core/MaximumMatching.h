@@ -0,0 +1,68 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_MAXIMUM_MATCHING_H
+#define __INET_MAXIMUM_MATCHING_H
+
+#include <vector>
+
+/** @brief Maximum cardinality matching in a general graph (Edmonds' blossom algorithm).
+ *
+ * Transmitter and recipient roles are not fixed, so the link graph is not
+ * bipartite and odd cycles have to be contracted. The matching starts from a
+ * greedy pass that matches low-degree vertices first, then every unmatched
+ * vertex is tried once as the root of an augmenting path search. The tree of a
+ * failed search can never take part in an augmenting path again and is pruned.
+ * Per-search state is reset through the list of visited vertices only, so a
+ * search costs time proportional to the part of the graph it reaches.
+ */
+class MaximumMatching
+{
+    public:
+        void reset(int numVertices); // Removes all edges and matches
+        void addEdge(int u, int v);
+        void solve();
+
+        int getNumVertices() const { return (int)adjacency.size(); }
+        int getMate(int v) const { return mate[v]; } // -1 if unmatched
+
+    protected:
+        std::vector<std::vector<int>> adjacency;
+        std::vector<int> mate;
+
+        // Augmenting path search
+        std::vector<int> parent;
+        std::vector<int> base; // Base vertex of the blossom containing each vertex
+        std::vector<bool> inTree;
+        std::vector<bool> inBlossom;
+        std::vector<bool> pruned; // Vertex of an earlier failed search tree
+        std::vector<int> visitStamp; // Vertex belongs to the current search if equal to searchStamp
+        std::vector<int> lcaStamp;
+        std::vector<int> visited;
+        std::vector<int> queue;
+        int searchStamp = 0;
+        int lcaCounter = 0;
+
+        void matchGreedily();
+        void visit(int v);
+        int findAugmentingPath(int root); // Returns the unmatched end of the path, -1 if there is none
+        int findCommonBase(int a, int b);
+        void markBlossomPath(int v, int blossomBase, int child);
+        void augment(int end);
+        void pruneSearchTree();
+};
+
+#endif
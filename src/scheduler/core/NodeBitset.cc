@@ -0,0 +1,80 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "NodeBitset.h"
+#include <algorithm>
+
+void NodeBitset::resize(int bits) {
+    numBits = bits;
+    words.assign(numWordsFor(bits), 0);
+}
+
+void NodeBitset::clear() {
+    std::fill(words.begin(), words.end(), 0);
+}
+
+void NodeBitset::andNot(const uint64_t *other) {
+    // Simple loop over restrict pointers, auto-vectorised by the compiler
+    uint64_t *__restrict target = words.data();
+    const uint64_t *__restrict source = other;
+    int numWords = (int)words.size();
+    for (int w = 0; w < numWords; ++w) {
+        target[w] &= ~source[w];
+    }
+}
+
+void NodeBitset::orWith(const uint64_t *other) {
+    uint64_t *__restrict target = words.data();
+    const uint64_t *__restrict source = other;
+    int numWords = (int)words.size();
+    for (int w = 0; w < numWords; ++w) {
+        target[w] |= source[w];
+    }
+}
+
+bool NodeBitset::any() const {
+    for (uint64_t word : words) {
+        if (word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int NodeBitset::count() const {
+    int total = 0;
+    for (uint64_t word : words) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+int NodeBitset::findNth(int n) const {
+    for (int w = 0; w < (int)words.size(); ++w) {
+        uint64_t word = words[w];
+        int bitsInWord = __builtin_popcountll(word);
+        if (n >= bitsInWord) {
+            n -= bitsInWord;
+            continue;
+        }
+        // Drop the lowest n set bits, the next one is the result
+        for (int i = 0; i < n; ++i) {
+            word &= word - 1;
+        }
+        return w * 64 + __builtin_ctzll(word);
+    }
+    return -1;
+}
@@ -0,0 +1,71 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_NODE_BITSET_H
+#define __INET_NODE_BITSET_H
+
+#include <cstdint>
+#include <vector>
+
+/** @brief Packed set of graph indices, one bit per node.
+ *
+ * Set operations work word-wise on plain uint64_t arrays so that the compiler
+ * can vectorise them; conflict rows of ConflictSets can be applied directly.
+ */
+class NodeBitset
+{
+    public:
+        static int numWordsFor(int numBits) { return (numBits + 63) / 64; }
+
+        NodeBitset() {}
+        explicit NodeBitset(int numBits) { resize(numBits); }
+
+        void resize(int numBits); // Resizes and clears all bits
+        int size() const { return numBits; }
+        int getNumWords() const { return (int)words.size(); }
+        const uint64_t *data() const { return words.data(); }
+
+        void set(int bit) { words[bit >> 6] |= uint64_t(1) << (bit & 63); }
+        void reset(int bit) { words[bit >> 6] &= ~(uint64_t(1) << (bit & 63)); }
+        bool test(int bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+        void clear();
+
+        void andNot(const uint64_t *other); // this &= ~other, other must have the same number of words
+        void orWith(const uint64_t *other); // this |= other
+        bool any() const;
+        int count() const;
+        int findNth(int n) const; // Index of the n-th (0-based) set bit, -1 if there are fewer bits set
+
+        template<typename Visitor>
+        void forEachSetBit(Visitor visit) const;
+
+    protected:
+        int numBits = 0;
+        std::vector<uint64_t> words;
+};
+
+template<typename Visitor>
+void NodeBitset::forEachSetBit(Visitor visit) const {
+    for (int w = 0; w < (int)words.size(); ++w) {
+        uint64_t word = words[w];
+        while (word) {
+            visit(w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,117 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "P2PReservations.h"
+
+#include <algorithm>
+
+void P2PReservationTable::configure(int activationGrants, int lifetimeSlots, int idleTimeout, int maxPeriodSlots) {
+    this->activationGrants = std::max(1, activationGrants);
+    this->lifetimeSlots = std::max(0, lifetimeSlots);
+    this->idleTimeout = std::max(1, idleTimeout);
+    this->maxPeriodSlots = std::max(1, maxPeriodSlots);
+    reservations.clear();
+    history.clear();
+}
+
+bool P2PReservationTable::hasReservation(int transmitter, int recipient) const {
+    for (const P2PReservation& reservation : reservations) {
+        if (reservation.transmitter == transmitter && reservation.recipient == recipient && !reservation.released) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void P2PReservationTable::collectDue(int slot, std::vector<int>& indices) {
+    indices.clear();
+    for (int i = 0; i < (int)reservations.size(); ++i) {
+        P2PReservation& reservation = reservations[i];
+        if (reservation.released) {
+            continue;
+        }
+        // Occurrences that were not planned (e.g. before the first pass of a frame) are dropped
+        if (reservation.nextSlot < slot) {
+            int missed = (slot - reservation.nextSlot + reservation.periodSlots - 1) / reservation.periodSlots;
+            reservation.nextSlot += missed * reservation.periodSlots;
+        }
+        if (reservation.nextSlot >= reservation.expirySlot) {
+            reservation.released = true;
+        }
+        else if (reservation.nextSlot == slot) {
+            indices.push_back(i);
+        }
+    }
+}
+
+void P2PReservationTable::completeOccurrence(int index, Occurrence occurrence) {
+    P2PReservation& reservation = reservations[index];
+    if (occurrence == SERVED) {
+        reservation.idleOccurrences = 0;
+    }
+    else if (occurrence == IDLE && ++reservation.idleOccurrences >= idleTimeout) {
+        reservation.released = true;
+    }
+    reservation.nextSlot += reservation.periodSlots;
+    if (reservation.nextSlot >= reservation.expirySlot) {
+        reservation.released = true;
+    }
+}
+
+void P2PReservationTable::recordDynamicGrant(int transmitter, int recipient, int slot) {
+    if (!isEnabled() || hasReservation(transmitter, recipient)) {
+        return;
+    }
+    GrantHistory& entry = history[std::make_pair(transmitter, recipient)];
+    int gap = slot - entry.lastSlot;
+    if (entry.grants > 0 && gap > 0 && gap <= maxPeriodSlots) {
+        entry.periodSlots = gap;
+        ++entry.grants;
+    }
+    else {
+        entry.grants = 1;
+    }
+    entry.lastSlot = slot;
+    if (entry.grants < activationGrants || entry.periodSlots <= 0) {
+        return;
+    }
+
+    P2PReservation reservation;
+    reservation.transmitter = transmitter;
+    reservation.recipient = recipient;
+    reservation.periodSlots = entry.periodSlots;
+    reservation.nextSlot = slot + entry.periodSlots;
+    reservation.expirySlot = slot + 1 + lifetimeSlots;
+    reservations.push_back(reservation);
+    history.erase(std::make_pair(transmitter, recipient));
+}
+
+void P2PReservationTable::removeReleased() {
+    reservations.erase(std::remove_if(reservations.begin(), reservations.end(),
+            [](const P2PReservation& reservation) { return reservation.released; }), reservations.end());
+}
+
+void P2PReservationTable::expireHistory(int slot) {
+    for (auto it = history.begin(); it != history.end();) {
+        if (slot - it->second.lastSlot > maxPeriodSlots) {
+            it = history.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
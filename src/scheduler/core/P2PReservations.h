@@ -0,0 +1,96 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef __INET_P2P_RESERVATIONS_H
+#define __INET_P2P_RESERVATIONS_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+/** @brief Semi-persistent P2P link: the transmitter owns every periodSlots-th slot towards the recipient. */
+struct P2PReservation
+{
+    int transmitter;
+    int recipient;
+    int periodSlots;
+    int nextSlot; // Global index of the next reserved slot
+    int expirySlot; // Global index of the first slot no longer covered
+    int idleOccurrences = 0; // Consecutive reserved slots that carried no packet
+    bool released = false;
+};
+
+/** @brief Semi-persistent reservations of steady P2P flows.
+ *
+ * A transmitter/recipient pair that was granted activationGrants times in a row
+ * with gaps of at most maxPeriodSlots is promoted to a reservation: the gap of its
+ * last two grants becomes the period and the reservation lasts lifetimeSlots.
+ * It is released earlier after idleTimeout consecutive reserved slots without
+ * backlog. Occurrences that clash with other traffic are skipped and neither
+ * count as served nor as idle. Reservations are kept in creation order, so older
+ * reservations win clashes among each other.
+ */
+class P2PReservationTable
+{
+    public:
+        enum Occurrence { SKIPPED, IDLE, SERVED };
+
+        void configure(int activationGrants, int lifetimeSlots, int idleTimeout, int maxPeriodSlots);
+        bool isEnabled() const { return lifetimeSlots > 0; }
+
+        int size() const { return (int)reservations.size(); }
+        const P2PReservation& at(int i) const { return reservations[i]; }
+        bool hasReservation(int transmitter, int recipient) const;
+
+        void collectDue(int slot, std::vector<int>& indices); // Reservations with an occurrence in the slot, occurrences before it are dropped
+        void completeOccurrence(int index, Occurrence occurrence); // Advances the reservation to its next occurrence or releases it
+        void recordDynamicGrant(int transmitter, int recipient, int slot); // Counts a policy grant and promotes steady pairs
+        void removeReleased();
+        void expireHistory(int slot); // Forgets pairs that were not granted within maxPeriodSlots
+
+        // Releases every reservation for which shouldRelease(reservation) holds and returns their number
+        template<typename Predicate>
+        int release(Predicate shouldRelease) {
+            int count = 0;
+            for (P2PReservation& reservation : reservations) {
+                if (!reservation.released && shouldRelease(reservation)) {
+                    reservation.released = true;
+                    ++count;
+                }
+            }
+            removeReleased();
+            return count;
+        }
+
+    protected:
+        /** @brief Recent policy grants of one pair that has no reservation yet. */
+        struct GrantHistory
+        {
+            int lastSlot = 0;
+            int periodSlots = 0;
+            int grants = 0;
+        };
+
+        int activationGrants = 3;
+        int lifetimeSlots = 0;
+        int idleTimeout = 2;
+        int maxPeriodSlots = 0;
+        std::vector<P2PReservation> reservations;
+        std::map<std::pair<int, int>, GrantHistory> history;
+};
+
+#endif
@@ -0,0 +1,59 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_PARALLEL_FOR_H
+#define __INET_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/** @brief Resolves a configured thread count, where 0 means one thread per hardware core. */
+inline int resolveNumThreads(int numThreads) {
+    if (numThreads > 0) {
+        return numThreads;
+    }
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+/** @brief Splits [0, numItems) into numChunks contiguous chunks and runs body(chunk, begin, end) for each.
+ *
+ * Chunk c always covers the same index range for a given numChunks, so callers that
+ * write per-chunk results and concatenate them in chunk order get a result that does
+ * not depend on scheduling. With one chunk the body runs on the calling thread.
+ */
+template<typename Body>
+void parallelFor(int numItems, int numChunks, Body body) {
+    numChunks = std::max(1, std::min(numChunks, numItems));
+    if (numChunks == 1) {
+        body(0, 0, numItems);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(numChunks - 1);
+    for (int chunk = 1; chunk < numChunks; ++chunk) {
+        int begin = (int)((long long)numItems * chunk / numChunks);
+        int end = (int)((long long)numItems * (chunk + 1) / numChunks);
+        workers.emplace_back([=]() { body(chunk, begin, end); });
+    }
+    // The calling thread takes the first chunk itself
+    body(0, 0, (int)((long long)numItems / numChunks));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "PhaseTimers.h"
+#include <algorithm>
+#include <iomanip>
+
+void PhaseTimers::configure(const std::vector<std::string>& phaseNames, IPhaseListener *listener) {
+    names = phaseNames;
+    counts.assign(names.size(), 0);
+    totals.assign(names.size(), 0);
+    maxima.assign(names.size(), 0);
+    this->listener = listener;
+}
+
+bool PhaseTimers::openTimeline(const std::string& path) {
+    timeline.open(path, std::ios::out | std::ios::trunc);
+    if (!timeline.is_open()) {
+        return false;
+    }
+    origin = Clock::now();
+    firstEvent = true;
+    timeline << std::fixed << std::setprecision(6);
+    timeline << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    return true;
+}
+
+void PhaseTimers::closeTimeline() {
+    if (!timeline.is_open()) {
+        return;
+    }
+    timeline << "\n]}\n";
+    timeline.close();
+}
+
+void PhaseTimers::record(int phase, Clock::time_point begin, Clock::time_point end, double simTime) {
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    ++counts[phase];
+    totals[phase] += seconds;
+    maxima[phase] = std::max(maxima[phase], seconds);
+    if (listener != nullptr) {
+        listener->phaseCompleted(phase, seconds);
+    }
+    if (timeline.is_open()) {
+        // Trace-event timestamps and durations are in microseconds
+        double timestamp = std::chrono::duration<double, std::micro>(begin - origin).count();
+        if (!firstEvent) {
+            timeline << ",\n";
+        }
+        firstEvent = false;
+        timeline << "{\"name\":\"" << names[phase] << "\",\"cat\":\"scheduler\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << timestamp
+                << ",\"dur\":" << seconds * 1e6 << ",\"args\":{\"simTime\":" << simTime << "}}";
+    }
+}
@@ -0,0 +1,102 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef __INET_PHASE_TIMERS_H
+#define __INET_PHASE_TIMERS_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** @brief Receives the wall time of every timed phase invocation, e.g. to fill histograms. */
+class IPhaseListener
+{
+    public:
+        virtual ~IPhaseListener() {}
+        virtual void phaseCompleted(int phase, double seconds) = 0;
+};
+
+/** @brief Wall-clock accounting of named hot-path phases with an optional Chrome trace-event timeline.
+ *
+ * Phases are timed by PHASE_TIMER scopes, which only exist if the model is built
+ * with -DLDACS_PHASE_TIMERS, so timers cost nothing otherwise. Nested scopes are
+ * inclusive, e.g. the logging inside a scheduling pass counts towards both. The
+ * timeline is a JSON file for chrome://tracing or Perfetto with one complete ("X")
+ * event per invocation, annotated with the simulation time.
+ */
+class PhaseTimers
+{
+    public:
+#ifdef LDACS_PHASE_TIMERS
+        static const bool COMPILED_IN = true;
+#else
+        static const bool COMPILED_IN = false;
+#endif
+        using Clock = std::chrono::steady_clock;
+
+        ~PhaseTimers() { closeTimeline(); }
+
+        void configure(const std::vector<std::string>& phaseNames, IPhaseListener *listener = nullptr);
+        bool openTimeline(const std::string& path); // Truncates the file and starts the trace-event array
+        void closeTimeline(); // Terminates the JSON document
+
+        void record(int phase, Clock::time_point begin, Clock::time_point end, double simTime);
+
+        int getNumPhases() const { return (int)names.size(); }
+        const std::string& getName(int phase) const { return names[phase]; }
+        int64_t getCount(int phase) const { return counts[phase]; }
+        double getTotal(int phase) const { return totals[phase]; } // Seconds
+        double getMax(int phase) const { return maxima[phase]; } // Seconds
+
+    protected:
+        std::vector<std::string> names;
+        std::vector<int64_t> counts;
+        std::vector<double> totals;
+        std::vector<double> maxima;
+        IPhaseListener *listener = nullptr;
+        std::ofstream timeline;
+        Clock::time_point origin = Clock::now(); // Timestamp zero of the timeline
+        bool firstEvent = true;
+};
+
+/** @brief Times the enclosing scope as one invocation of a phase. */
+class ScopedPhaseTimer
+{
+    public:
+        ScopedPhaseTimer(PhaseTimers& timers, int phase, double simTime) : timers(timers), phase(phase), simTime(simTime), begin(PhaseTimers::Clock::now()) {}
+        ~ScopedPhaseTimer() { timers.record(phase, begin, PhaseTimers::Clock::now(), simTime); }
+        ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+        ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+    protected:
+        PhaseTimers& timers;
+        int phase;
+        double simTime;
+        PhaseTimers::Clock::time_point begin;
+};
+
+#define PHASE_TIMER_CONCAT(a, b) a##b
+#define PHASE_TIMER_NAME(line) PHASE_TIMER_CONCAT(phaseTimer, line)
+#ifdef LDACS_PHASE_TIMERS
+#define PHASE_TIMER(timers, phase, simTime) ScopedPhaseTimer PHASE_TIMER_NAME(__LINE__)(timers, phase, simTime)
+#else
+#define PHASE_TIMER(timers, phase, simTime) ((void)0)
+#endif
+
+#endif
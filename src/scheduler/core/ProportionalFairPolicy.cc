@@ -0,0 +1,91 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ProportionalFairPolicy.h"
+#include <algorithm>
+
+ServiceAverage::ServiceAverage(int windowSlots) {
+    smoothing = 1.0 / std::max(1, windowSlots);
+}
+
+void ServiceAverage::update(int nodeId, bool served) {
+    if (nodeId >= (int)averages.size()) {
+        averages.resize(nodeId + 1, 0);
+    }
+    averages[nodeId] += smoothing * ((served ? 1.0 : 0.0) - averages[nodeId]);
+}
+
+void ProportionalFairPolicySH::assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource&, std::vector<std::vector<int>>& nodeSlots) {
+    state.reset(snapshot, nodeSlots);
+    int numGraphNodes = (int)snapshot.nodeIds.size();
+    for (int slot = 0; slot < snapshot.numSlots; ++slot) {
+        state.collectCandidates(slot, availableNodes);
+        order.clear();
+        availableNodes.forEachSetBit([&](int index) { order.push_back(index); });
+        // Every backlogged node could send one packet, so the PF metric reduces to the inverse average service
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            double serviceA = service.get(snapshot.nodeIds[a]);
+            double serviceB = service.get(snapshot.nodeIds[b]);
+            if (serviceA != serviceB) {
+                return serviceA < serviceB;
+            }
+            return state.getRemaining(a) > state.getRemaining(b);
+        });
+
+        servedNodes.resize(numGraphNodes);
+        for (int index : order) {
+            if (!availableNodes.test(index)) {
+                continue;
+            }
+            state.assign(index, slot, nodeSlots);
+            servedNodes.set(index);
+            availableNodes.reset(index);
+            availableNodes.andNot(snapshot.conflicts->getRow(index));
+        }
+        for (int index = 0; index < numGraphNodes; ++index) {
+            service.update(snapshot.nodeIds[index], servedNodes.test(index));
+        }
+    }
+}
+
+void ProportionalFairPolicyP2P::assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource&, std::vector<P2PLink>& links) {
+    links.clear();
+    state.reset(snapshot);
+    order = snapshot.candidates;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        double serviceA = service.get(a);
+        double serviceB = service.get(b);
+        if (serviceA != serviceB) {
+            return serviceA < serviceB;
+        }
+        return snapshot.bufferStatus[a] > snapshot.bufferStatus[b];
+    });
+
+    std::vector<bool> served(snapshot.busySH.size(), false);
+    for (int transmitter : order) {
+        if ((int)links.size() >= snapshot.maxLinks) {
+            break;
+        }
+        int recipient = state.findFeasibleRecipient(snapshot, transmitter);
+        if (recipient != -1) {
+            state.assign(transmitter, recipient, links);
+            served[transmitter] = true;
+        }
+    }
+    for (int nodeId = 0; nodeId < (int)served.size(); ++nodeId) {
+        service.update(nodeId, served[nodeId]);
+    }
+}
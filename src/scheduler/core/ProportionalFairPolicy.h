@@ -0,0 +1,64 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_PROPORTIONAL_FAIR_POLICY_H
+#define __INET_PROPORTIONAL_FAIR_POLICY_H
+
+#include "SchedulingPolicy.h"
+
+/** @brief Exponentially averaged share of slots each node got, keyed by node ID so it survives graph rebuilds. */
+class ServiceAverage
+{
+    public:
+        explicit ServiceAverage(int windowSlots);
+
+        double get(int nodeId) const { return nodeId < (int)averages.size() ? averages[nodeId] : 0; }
+        void update(int nodeId, bool served); // Advances the node's average by one slot
+
+    protected:
+        double smoothing; // 1 / averaging window in slots
+        std::vector<double> averages;
+};
+
+/** @brief Proportional-fair SH assignment: every slot prefers the backlogged nodes with the lowest average service. */
+class ProportionalFairPolicySH: public ISchedulingPolicySH
+{
+    public:
+        explicit ProportionalFairPolicySH(int windowSlots) : service(windowSlots) {}
+        void assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource& random, std::vector<std::vector<int>>& nodeSlots) override;
+
+    protected:
+        ServiceAverage service;
+        FrameStateSH state;
+        NodeBitset availableNodes;
+        NodeBitset servedNodes;
+        std::vector<int> order;
+};
+
+/** @brief Proportional-fair P2P assignment: links are added in order of increasing average transmitter service. */
+class ProportionalFairPolicyP2P: public ISchedulingPolicyP2P
+{
+    public:
+        explicit ProportionalFairPolicyP2P(int windowSlots) : service(windowSlots) {}
+        void assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links) override;
+
+    protected:
+        ServiceAverage service;
+        SlotStateP2P state;
+        std::vector<int> order;
+};
+
+#endif
@@ -0,0 +1,60 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "RandomPolicy.h"
+
+void RandomPolicySH::assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource& random, std::vector<std::vector<int>>& nodeSlots) {
+    state.reset(snapshot, nodeSlots);
+    for (int slot = 0; slot < snapshot.numSlots; ++slot) {
+        state.collectCandidates(slot, availableNodes);
+        candidates.reset(availableNodes.size());
+        availableNodes.forEachSetBit([&](int index) { candidates.insert(index); });
+
+        while (!candidates.empty()) {
+            int selectedIndex = candidates.takeAt(random.uniformInt(0, candidates.size() - 1));
+            if (!availableNodes.test(selectedIndex)) {
+                continue; // Already removed as neighbor of an earlier selection
+            }
+            state.assign(selectedIndex, slot, nodeSlots);
+            availableNodes.reset(selectedIndex);
+            // Remove 1-hop and 2-hop neighbors from available nodes to avoid interference
+            availableNodes.andNot(snapshot.conflicts->getRow(selectedIndex));
+        }
+    }
+}
+
+void RandomPolicyP2P::assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links) {
+    links.clear();
+    state.reset(snapshot);
+    candidates.reset((int)snapshot.busySH.size());
+    for (int nodeId : snapshot.candidates) {
+        candidates.insert(nodeId);
+    }
+
+    while (!candidates.empty() && (int)links.size() < snapshot.maxLinks) {
+        int transmitter = candidates.takeAt(random.uniformInt(0, candidates.size() - 1));
+        int recipient = state.findFeasibleRecipient(snapshot, transmitter);
+        if (recipient != -1) {
+            state.assign(transmitter, recipient, links);
+        }
+        // Busy recipients cannot transmit in this slot either
+        for (const P2PDemand& demand : snapshot.demands[transmitter]) {
+            if (demand.recipient >= 0 && state.isBlocked(snapshot, demand.recipient)) {
+                candidates.remove(demand.recipient);
+            }
+        }
+    }
+}
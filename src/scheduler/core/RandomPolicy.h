@@ -0,0 +1,46 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_RANDOM_POLICY_H
+#define __INET_RANDOM_POLICY_H
+
+#include "CandidatePool.h"
+#include "SchedulingPolicy.h"
+
+/** @brief Fills every SH slot with a random maximal set of non-conflicting nodes. */
+class RandomPolicySH: public ISchedulingPolicySH
+{
+    public:
+        void assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource& random, std::vector<std::vector<int>>& nodeSlots) override;
+
+    protected:
+        FrameStateSH state;
+        NodeBitset availableNodes;
+        CandidatePool candidates; // Random selection pool, entries cleared from availableNodes are discarded lazily
+};
+
+/** @brief Draws transmitters at random, each takes its first demand that is still feasible. */
+class RandomPolicyP2P: public ISchedulingPolicyP2P
+{
+    public:
+        void assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links) override;
+
+    protected:
+        SlotStateP2P state;
+        CandidatePool candidates;
+};
+
+#endif
@@ -0,0 +1,57 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef __INET_SCHEDULE_METRICS_H
+#define __INET_SCHEDULE_METRICS_H
+
+#include <algorithm>
+#include <vector>
+
+/** @brief Slot usage of one channel over one SH frame or one P2P pass. */
+struct ChannelMetrics
+{
+    int slots = 0; // Slots covered by the frame or pass
+    int usedSlots = 0; // Slots with at least one transmitter
+    int transmissions = 0; // Granted slots, one packet each
+    int backlog = 0; // Packets queued when the slots were granted
+
+    double getUtilization() const { return slots > 0 ? (double)usedSlots / slots : 0; }
+    double getSpatialReuse() const { return usedSlots > 0 ? (double)transmissions / usedSlots : 0; } // Concurrent transmitters per used slot
+    int getUnassignedBacklog() const { return std::max(0, backlog - transmissions); }
+};
+
+/** @brief Counts slot usage while slots are granted, so no pass over the finished schedule is needed. */
+class ChannelMetricsCounter
+{
+    public:
+        void begin(int numSlots, int backlog); // Starts a new frame or pass
+        void addTransmission(int slot) {
+            if (transmittersPerSlot[slot]++ == 0) {
+                ++metrics.usedSlots;
+            }
+            ++metrics.transmissions;
+        }
+        void addBacklog(int packets) { metrics.backlog += packets; } // Packets that show up after begin(), e.g. for mid-frame grants
+        bool isActive() const { return metrics.slots > 0; }
+        const ChannelMetrics& get() const { return metrics; }
+
+    protected:
+        ChannelMetrics metrics;
+        std::vector<int> transmittersPerSlot;
+};
+
+#endif
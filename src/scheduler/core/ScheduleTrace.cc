@@ -0,0 +1,325 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "ScheduleTrace.h"
+
+#include <algorithm>
+
+bool ScheduleTraceWriter::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    buffer.clear();
+    buffer.reserve(BUFFER_SIZE);
+    lastSlotSH = 0;
+    lastSlotP2P = 0;
+    lastGrantTime = 0;
+    lastBufferSH.clear();
+    lastBufferP2P.clear();
+    for (char c : ScheduleTrace::MAGIC) {
+        writeByte((uint8_t)c);
+    }
+    writeVarint(ScheduleTrace::VERSION);
+    return true;
+}
+
+void ScheduleTraceWriter::close() {
+    if (!file.is_open()) {
+        return;
+    }
+    writeByte(ScheduleTrace::END);
+    flush();
+    file.close();
+}
+
+void ScheduleTraceWriter::writeFrameSH(int frameStartSlot, const std::vector<int>& bufferStatus, const std::vector<std::vector<int>>& slotNodes) {
+    writeByte(ScheduleTrace::FRAME_SH);
+    writeSigned(frameStartSlot - lastSlotSH);
+    lastSlotSH = frameStartSlot;
+    writeBufferSnapshot(bufferStatus, lastBufferSH);
+    writeVarint(slotNodes.size());
+    for (const std::vector<int>& nodes : slotNodes) {
+        sortedNodes.assign(nodes.begin(), nodes.end());
+        writeSortedNodes(sortedNodes);
+    }
+    if (buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void ScheduleTraceWriter::writeGrantSH(int64_t time, int nodeId, const std::vector<int>& localSlots) {
+    writeByte(ScheduleTrace::GRANT_SH);
+    writeSigned(time - lastGrantTime);
+    lastGrantTime = time;
+    writeVarint(nodeId);
+    sortedNodes.assign(localSlots.begin(), localSlots.end());
+    writeSortedNodes(sortedNodes);
+    if (buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void ScheduleTraceWriter::writePassP2P(int firstSlot, const std::vector<int>& bufferStatus, const std::vector<std::vector<P2PLink>>& slotLinks) {
+    writeByte(ScheduleTrace::PASS_P2P);
+    writeSigned(firstSlot - lastSlotP2P);
+    lastSlotP2P = firstSlot;
+    writeBufferSnapshot(bufferStatus, lastBufferP2P);
+    writeVarint(slotLinks.size());
+    for (const std::vector<P2PLink>& links : slotLinks) {
+        sortedLinks.assign(links.begin(), links.end());
+        std::sort(sortedLinks.begin(), sortedLinks.end(), [](const P2PLink& a, const P2PLink& b) { return a.transmitter < b.transmitter; });
+        writeVarint(sortedLinks.size());
+        int previous = 0;
+        for (const P2PLink& link : sortedLinks) {
+            writeVarint(link.transmitter - previous);
+            writeSigned(link.recipient - link.transmitter);
+            previous = link.transmitter;
+        }
+    }
+    if (buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void ScheduleTraceWriter::writeByte(uint8_t value) {
+    buffer.push_back(value);
+}
+
+void ScheduleTraceWriter::writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+}
+
+void ScheduleTraceWriter::writeBufferSnapshot(const std::vector<int>& bufferStatus, std::vector<int>& lastBuffer) {
+    // Nodes that registered since the last snapshot start from 0
+    lastBuffer.resize(bufferStatus.size(), 0);
+    writeVarint(bufferStatus.size());
+    for (size_t i = 0; i < bufferStatus.size(); ++i) {
+        writeSigned(bufferStatus[i] - lastBuffer[i]);
+        lastBuffer[i] = bufferStatus[i];
+    }
+}
+
+void ScheduleTraceWriter::writeSortedNodes(std::vector<int>& nodes) {
+    std::sort(nodes.begin(), nodes.end());
+    writeVarint(nodes.size());
+    int previous = 0;
+    for (int node : nodes) {
+        writeVarint(node - previous);
+        previous = node;
+    }
+}
+
+void ScheduleTraceWriter::flush() {
+    file.write((const char *)buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+bool ScheduleTraceReader::open(const std::string& path) {
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    error.clear();
+    for (char c : ScheduleTrace::MAGIC) {
+        uint8_t value;
+        if (!readByte(value) || value != (uint8_t)c) {
+            error = "not a schedule trace";
+            return false;
+        }
+    }
+    int version;
+    if (!readInt(version) || version != ScheduleTrace::VERSION) {
+        error = "unsupported schedule trace version";
+        return false;
+    }
+    return true;
+}
+
+ScheduleTrace::RecordType ScheduleTraceReader::next() {
+    uint8_t type;
+    if (!readByte(type)) {
+        return fail("trace ends without END record");
+    }
+    switch (type) {
+        case ScheduleTrace::END:
+            return ScheduleTrace::END;
+        case ScheduleTrace::FRAME_SH: {
+            // Every frame has the length of the first one
+            int delta, numSlots;
+            int maxSlots = frameSH.slotNodes.empty() ? ScheduleTrace::MAX_SLOTS : (int)frameSH.slotNodes.size();
+            if (!readSigned(delta) || !readBufferSnapshot(frameSH.bufferStatus) || !readCount(numSlots, maxSlots)) {
+                return fail("truncated FRAME_SH record");
+            }
+            lastSlotSH += delta;
+            frameSH.frameStartSlot = lastSlotSH;
+            frameSH.nodeId = -1;
+            frameSH.localSlots.clear();
+            frameSH.slotNodes.resize(numSlots);
+            for (std::vector<int>& nodes : frameSH.slotNodes) {
+                if (!readSortedNodes(nodes, (int)frameSH.bufferStatus.size())) {
+                    return fail("truncated FRAME_SH record");
+                }
+            }
+            return ScheduleTrace::FRAME_SH;
+        }
+        case ScheduleTrace::GRANT_SH: {
+            int64_t delta;
+            if (!readSigned64(delta) || !readInt(frameSH.nodeId) || !readSortedNodes(frameSH.localSlots, (int)frameSH.slotNodes.size())) {
+                return fail("truncated GRANT_SH record");
+            }
+            lastGrantTime += delta;
+            frameSH.grantTime = lastGrantTime;
+            return ScheduleTrace::GRANT_SH;
+        }
+        case ScheduleTrace::PASS_P2P: {
+            int delta, numSlots;
+            if (!readSigned(delta) || !readBufferSnapshot(passP2P.bufferStatus) || !readCount(numSlots, ScheduleTrace::MAX_SLOTS)) {
+                return fail("truncated PASS_P2P record");
+            }
+            lastSlotP2P += delta;
+            passP2P.firstSlot = lastSlotP2P;
+            passP2P.slotLinks.resize(numSlots);
+            for (std::vector<P2PLink>& links : passP2P.slotLinks) {
+                int numLinks;
+                if (!readCount(numLinks, (int)passP2P.bufferStatus.size())) {
+                    return fail("truncated PASS_P2P record");
+                }
+                links.resize(numLinks);
+                int previous = 0;
+                for (P2PLink& link : links) {
+                    int gap, offset;
+                    if (!readInt(gap) || !readSigned(offset)) {
+                        return fail("truncated PASS_P2P record");
+                    }
+                    link.transmitter = previous + gap;
+                    link.recipient = link.transmitter + offset;
+                    previous = link.transmitter;
+                }
+            }
+            return ScheduleTrace::PASS_P2P;
+        }
+        default:
+            return fail("unknown record type " + std::to_string(type));
+    }
+}
+
+bool ScheduleTraceReader::readByte(uint8_t& value) {
+    int c = file.rdbuf()->sbumpc();
+    if (c == std::char_traits<char>::eof()) {
+        return false;
+    }
+    value = (uint8_t)c;
+    return true;
+}
+
+bool ScheduleTraceReader::readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!readByte(byte)) {
+            return false;
+        }
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ScheduleTraceReader::readInt(int& value) {
+    uint64_t raw;
+    if (!readVarint(raw)) {
+        return false;
+    }
+    value = (int)raw;
+    return true;
+}
+
+bool ScheduleTraceReader::readCount(int& count, int maxCount) {
+    uint64_t raw;
+    if (!readVarint(raw) || raw > (uint64_t)maxCount) {
+        return false;
+    }
+    count = (int)raw;
+    return true;
+}
+
+bool ScheduleTraceReader::readSigned(int& value) {
+    int64_t wide;
+    if (!readSigned64(wide)) {
+        return false;
+    }
+    value = (int)wide;
+    return true;
+}
+
+bool ScheduleTraceReader::readSigned64(int64_t& value) {
+    uint64_t raw;
+    if (!readVarint(raw)) {
+        return false;
+    }
+    value = (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+    return true;
+}
+
+bool ScheduleTraceReader::readBufferSnapshot(std::vector<int>& bufferStatus) {
+    // bufferStatus still holds the previous snapshot of the channel, which the deltas apply to
+    int numNodes;
+    if (!readCount(numNodes, ScheduleTrace::MAX_NODES)) {
+        return false;
+    }
+    bufferStatus.resize(numNodes, 0);
+    for (int& status : bufferStatus) {
+        int delta;
+        if (!readSigned(delta)) {
+            return false;
+        }
+        status += delta;
+    }
+    return true;
+}
+
+bool ScheduleTraceReader::readSortedNodes(std::vector<int>& nodes, int maxCount) {
+    int count;
+    if (!readCount(count, maxCount)) {
+        return false;
+    }
+    nodes.resize(count);
+    int previous = 0;
+    for (int& node : nodes) {
+        int gap;
+        if (!readInt(gap)) {
+            return false;
+        }
+        node = previous + gap;
+        previous = node;
+    }
+    return true;
+}
+
+ScheduleTrace::RecordType ScheduleTraceReader::fail(const std::string& message) {
+    error = message;
+    return ScheduleTrace::END;
+}
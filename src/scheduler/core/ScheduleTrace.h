@@ -0,0 +1,137 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef __INET_SCHEDULE_TRACE_H
+#define __INET_SCHEDULE_TRACE_H
+
+#include "SchedulingPolicy.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** @brief Binary schedule trace, format version 1.
+ *
+ * The file starts with the magic "LDST" and a varint version, followed by records
+ * that each start with a type byte:
+ *  - FRAME_SH: frame start slot, SH buffer snapshot, nodes of every slot of the frame.
+ *  - GRANT_SH: time of the grant, node and the local slots added to its grant in the running frame.
+ *  - PASS_P2P: first slot, P2P buffer snapshot, links of every planned slot.
+ *  - END: written on close, a trace without it was cut short.
+ * All integers are LEB128 varints, signed values are zigzag encoded. Slot indices
+ * are deltas to the previous record of the same channel, buffer snapshots are
+ * deltas to the previous snapshot of the same channel and sorted node IDs are
+ * stored as gaps, so steady schedules compress to a few bytes per slot.
+ */
+namespace ScheduleTrace {
+    const char MAGIC[4] = {'L', 'D', 'S', 'T'};
+    const int VERSION = 1;
+    // Bounds for the counts the reader decodes, so a damaged trace fails instead of allocating without limit
+    const int MAX_NODES = 1 << 20;
+    const int MAX_SLOTS = 1 << 16;
+    enum RecordType { END = 0, FRAME_SH = 1, GRANT_SH = 2, PASS_P2P = 3 };
+}
+
+/** @brief Streams schedule records through an in-memory buffer into a trace file. */
+class ScheduleTraceWriter
+{
+    public:
+        ~ScheduleTraceWriter() { close(); }
+
+        bool open(const std::string& path); // Truncates the file and writes the header
+        bool isOpen() const { return file.is_open(); }
+        void close(); // Writes the END record and flushes
+
+        void writeFrameSH(int frameStartSlot, const std::vector<int>& bufferStatus, const std::vector<std::vector<int>>& slotNodes);
+        void writeGrantSH(int64_t time, int nodeId, const std::vector<int>& localSlots); // time in the simulator's raw ticks
+        void writePassP2P(int firstSlot, const std::vector<int>& bufferStatus, const std::vector<std::vector<P2PLink>>& slotLinks);
+
+    protected:
+        static const size_t BUFFER_SIZE = 1 << 16;
+
+        std::ofstream file;
+        std::vector<uint8_t> buffer;
+        int lastSlotSH = 0;
+        int lastSlotP2P = 0;
+        int64_t lastGrantTime = 0;
+        std::vector<int> lastBufferSH;
+        std::vector<int> lastBufferP2P;
+        std::vector<int> sortedNodes;
+        std::vector<P2PLink> sortedLinks;
+
+        void writeByte(uint8_t value);
+        void writeVarint(uint64_t value);
+        void writeSigned(int64_t value) { writeVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63)); }
+        void writeBufferSnapshot(const std::vector<int>& bufferStatus, std::vector<int>& lastBuffer);
+        void writeSortedNodes(std::vector<int>& nodes);
+        void flush();
+};
+
+/** @brief SH record as decoded by the reader, a GRANT_SH record fills grantTime, nodeId and localSlots only. */
+struct ScheduleTraceFrameSH
+{
+    int frameStartSlot = 0;
+    std::vector<int> bufferStatus;
+    std::vector<std::vector<int>> slotNodes; // Ascending node IDs per local slot
+    int64_t grantTime = 0; // Raw simulation time of the grant
+    int nodeId = -1;
+    std::vector<int> localSlots;
+};
+
+/** @brief P2P record as decoded by the reader. */
+struct ScheduleTracePassP2P
+{
+    int firstSlot = 0;
+    std::vector<int> bufferStatus;
+    std::vector<std::vector<P2PLink>> slotLinks; // Links by ascending transmitter per planned slot
+};
+
+/** @brief Sequential decoder of a schedule trace. */
+class ScheduleTraceReader
+{
+    public:
+        bool open(const std::string& path); // Checks magic and version
+        const std::string& getError() const { return error; }
+
+        // Decodes the next record, END is returned at the end of the file and ok() tells whether the trace was complete
+        ScheduleTrace::RecordType next();
+        bool ok() const { return error.empty(); }
+
+        const ScheduleTraceFrameSH& getFrameSH() const { return frameSH; }
+        const ScheduleTracePassP2P& getPassP2P() const { return passP2P; }
+
+    protected:
+        std::ifstream file;
+        std::string error;
+        ScheduleTraceFrameSH frameSH;
+        ScheduleTracePassP2P passP2P;
+        int lastSlotSH = 0;
+        int lastSlotP2P = 0;
+        int64_t lastGrantTime = 0;
+
+        bool readByte(uint8_t& value);
+        bool readVarint(uint64_t& value);
+        bool readInt(int& value);
+        bool readCount(int& count, int maxCount); // Fails for counts above maxCount
+        bool readSigned(int& value);
+        bool readSigned64(int64_t& value);
+        bool readBufferSnapshot(std::vector<int>& bufferStatus);
+        bool readSortedNodes(std::vector<int>& nodes, int maxCount);
+        ScheduleTrace::RecordType fail(const std::string& message);
+};
+
+#endif
@@ -0,0 +1,188 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "SchedulerCore.h"
+
+#include <algorithm>
+
+SchedulerCore::~SchedulerCore() {
+    delete policySH;
+    delete policyP2P;
+}
+
+bool SchedulerCore::configure(const SchedulerCoreParameters& parameters) {
+    this->parameters = parameters;
+    minReassignmentDurationSH = parameters.slotDuration * parameters.minReassignmentSlotsSH;
+    minReassignmentDurationP2P = parameters.slotDuration * parameters.minReassignmentSlotsP2P;
+    delete policySH;
+    delete policyP2P;
+    policySH = createSchedulingPolicySH(parameters.policySH, parameters.policyParameters);
+    policyP2P = createSchedulingPolicyP2P(parameters.policyP2P, parameters.policyParameters);
+    spatialGrid.setCellSize(parameters.communicationRange);
+    incrementalConnectivity.configure(parameters.communicationRange, parameters.graphUpdateSlack);
+    return policySH != nullptr && policyP2P != nullptr;
+}
+
+void SchedulerCore::buildGraph(const std::vector<int>& activeNodeIds, const std::vector<NodePosition>& positions) {
+    edges.clear();
+    if (parameters.incrementalGraph) {
+        // Only nodes that were added or moved beyond the slack search for new neighbours
+        incrementalConnectivity.update(activeNodeIds, positions, edges);
+    }
+    else {
+        // Collect edges, only testing pairs in the same or adjacent grid cells
+        spatialGrid.build(positions);
+        spatialGrid.collectPairsWithinRange(positions, parameters.communicationRange, parameters.graphBuildThreads, edges);
+    }
+    graphPositions = positions;
+    spatialGridValid = !parameters.incrementalGraph;
+    int numVertices = (int)activeNodeIds.size();
+    graph.build(numVertices, edges);
+    // Conflict rows are computed once here instead of after every SH selection
+    conflictSets.build(graph, parameters.graphBuildThreads);
+
+    for (int nodeId : graphNodeIds) {
+        graphIndices[nodeId] = -1;
+    }
+    graphNodeIds = activeNodeIds;
+    for (int index = 0; index < numVertices; ++index) {
+        int nodeId = graphNodeIds[index];
+        if (nodeId >= (int)graphIndices.size()) {
+            graphIndices.resize(nodeId + 1, -1);
+        }
+        graphIndices[nodeId] = index;
+    }
+    visitMarks.assign(numVertices, 0);
+    visitStamp = 0;
+}
+
+bool SchedulerCore::isInRange(int nodeA, int nodeB) const {
+    int indexA = getGraphIndex(nodeA);
+    int indexB = getGraphIndex(nodeB);
+    return indexA != -1 && indexB != -1 && graph.isConnected(indexA, indexB);
+}
+
+void SchedulerCore::findNodesWithinTwoHops(int nodeId, std::vector<int>& nodeIds) {
+    nodeIds.clear();
+    int index = getGraphIndex(nodeId);
+    if (index == -1) {
+        return;
+    }
+    // A fresh stamp marks the indices visited by this query, avoiding a per-call set
+    if (++visitStamp == 0) {
+        std::fill(visitMarks.begin(), visitMarks.end(), 0);
+        visitStamp = 1;
+    }
+    visitMarks[index] = visitStamp; // Ensure not to add the original node
+    for (int i : graph.getNeighbours(index)) {
+        if (visitMarks[i] != visitStamp) {
+            visitMarks[i] = visitStamp;
+            nodeIds.push_back(graphNodeIds[i]);
+        }
+        for (int j : graph.getNeighbours(i)) {
+            if (visitMarks[j] != visitStamp) {
+                visitMarks[j] = visitStamp;
+                nodeIds.push_back(graphNodeIds[j]);
+            }
+        }
+    }
+}
+
+void SchedulerCore::findGraphNodesWithinTwoHops(const NodePosition& position, std::vector<int>& indices) {
+    indices.clear();
+    if (!spatialGridValid) {
+        spatialGrid.build(graphPositions);
+        spatialGridValid = true;
+    }
+    if (++visitStamp == 0) {
+        std::fill(visitMarks.begin(), visitMarks.end(), 0);
+        visitStamp = 1;
+    }
+    // Graph nodes in range of the position are its 1-hop neighbours, their neighbours the 2-hop ones
+    spatialGrid.forEachCandidate(position, [&](int i) {
+        if (visitMarks[i] != visitStamp && graphPositions[i].distance(position) <= parameters.communicationRange) {
+            visitMarks[i] = visitStamp;
+            indices.push_back(i);
+        }
+    });
+    int numOneHop = (int)indices.size();
+    for (int k = 0; k < numOneHop; ++k) {
+        for (int j : graph.getNeighbours(indices[k])) {
+            if (visitMarks[j] != visitStamp) {
+                visitMarks[j] = visitStamp;
+                indices.push_back(j);
+            }
+        }
+    }
+}
+
+SchedulingSnapshotSH SchedulerCore::createSnapshotSH(const std::vector<int>& bufferStatus, const std::vector<double>& lastAssignedTime, double frameStartTime) const {
+    SchedulingSnapshotSH snapshot;
+    int numGraphNodes = (int)graphNodeIds.size();
+    int numSlots = parameters.frameSlots;
+    snapshot.conflicts = &conflictSets;
+    snapshot.nodeIds = graphNodeIds;
+    snapshot.bufferStatus.resize(numGraphNodes);
+    snapshot.lastAssignedTime.resize(numGraphNodes);
+    snapshot.firstEligibleSlot.assign(numGraphNodes, numSlots);
+    snapshot.numSlots = numSlots;
+    snapshot.minSpacingSlots = parameters.minReassignmentSlotsSH;
+    snapshot.frameStartTime = frameStartTime;
+    snapshot.slotDuration = parameters.slotDuration;
+    for (int index = 0; index < numGraphNodes; ++index) {
+        int nodeId = graphNodeIds[index];
+        snapshot.bufferStatus[index] = bufferStatus[nodeId];
+        snapshot.lastAssignedTime[index] = lastAssignedTime[nodeId];
+        if (snapshot.bufferStatus[index] <= 0) {
+            continue;
+        }
+        for (int slot = 0; slot < numSlots; ++slot) {
+            if (isEligibleSH(lastAssignedTime[nodeId], frameStartTime + (slot * parameters.slotDuration))) {
+                snapshot.firstEligibleSlot[index] = slot;
+                break;
+            }
+        }
+    }
+    return snapshot;
+}
+
+void SchedulerCore::assignSlotsSH(const SchedulingSnapshotSH& snapshot, IRandomSource& random, std::vector<std::vector<int>>& nodeSlots) {
+    policySH->assignSlots(snapshot, random, nodeSlots);
+}
+
+SchedulingSnapshotP2P SchedulerCore::createSnapshotP2P(const std::vector<int>& bufferStatus, const std::vector<std::vector<P2PDemand>>& destinations,
+        const std::vector<double>& lastAssignedTime, const std::vector<bool>& busy, double slotStartTime) const {
+    int numNodes = (int)bufferStatus.size();
+    SchedulingSnapshotP2P snapshot;
+    snapshot.demands.resize(numNodes);
+    snapshot.bufferStatus = bufferStatus;
+    snapshot.lastAssignedTime = lastAssignedTime;
+    snapshot.busySH = busy;
+    snapshot.maxLinks = parameters.maxP2PLinks;
+    snapshot.slotStartTime = slotStartTime;
+    for (int nodeId = 0; nodeId < numNodes; ++nodeId) {
+        if (bufferStatus[nodeId] > 0 && isEligibleP2P(lastAssignedTime[nodeId], slotStartTime)) {
+            snapshot.candidates.push_back(nodeId);
+            snapshot.demands[nodeId] = destinations[nodeId];
+        }
+    }
+    return snapshot;
+}
+
+void SchedulerCore::assignLinksP2P(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links) {
+    policyP2P->assignLinks(snapshot, random, links);
+}
@@ -0,0 +1,111 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef __INET_SCHEDULER_CORE_H
+#define __INET_SCHEDULER_CORE_H
+
+#include "ConflictSets.h"
+#include "ConnectivityGraph.h"
+#include "IncrementalConnectivity.h"
+#include "SchedulingPolicy.h"
+#include "SpatialGrid.h"
+#include <string>
+#include <vector>
+
+/** @brief Configuration of the scheduler core, mirrors the parameters of the scheduler module. */
+struct SchedulerCoreParameters
+{
+    double communicationRange = 0; // meters
+    int frameSlots = 1; // Slots per SH frame (buildGraphIntervalSlots)
+    double slotDuration = 0; // seconds
+    int minReassignmentSlotsSH = 0;
+    int minReassignmentSlotsP2P = 0;
+    int maxP2PLinks = 0;
+    bool incrementalGraph = false;
+    double graphUpdateSlack = 0; // meters
+    int graphBuildThreads = 1;
+    std::string policySH = "random";
+    std::string policyP2P = "random";
+    SchedulingPolicyParameters policyParameters;
+};
+
+/** @brief Simulator independent part of the central TDMA scheduler.
+ *
+ * Builds the connectivity graph and conflict sets of the active nodes, turns
+ * plain per-node state into policy snapshots and runs the SH and P2P policies.
+ * Node state is passed in as vectors indexed by node ID and times are seconds,
+ * so the same code runs inside the OMNeT++ module and in standalone tools.
+ */
+class SchedulerCore
+{
+    public:
+        ~SchedulerCore();
+
+        bool configure(const SchedulerCoreParameters& parameters); // False if a policy name is unknown
+        const SchedulerCoreParameters& getParameters() const { return parameters; }
+
+        // Graph of the given nodes, graph index i belongs to activeNodeIds[i] at positions[i]
+        void buildGraph(const std::vector<int>& activeNodeIds, const std::vector<NodePosition>& positions);
+        const ConnectivityGraph& getGraph() const { return graph; }
+        const ConflictSets& getConflictSets() const { return conflictSets; }
+        const std::vector<int>& getGraphNodeIds() const { return graphNodeIds; }
+        int getGraphIndex(int nodeId) const { return nodeId >= 0 && nodeId < (int)graphIndices.size() ? graphIndices[nodeId] : -1; }
+        bool isInRange(int nodeA, int nodeB) const; // Whether both nodes are neighbours in the graph
+        void findNodesWithinTwoHops(int nodeId, std::vector<int>& nodeIds); // 1-hop and 2-hop neighbours as node IDs
+        void findGraphNodesWithinTwoHops(const NodePosition& position, std::vector<int>& indices); // Graph indices within two hops of a node at position that is not in the graph
+        int getNumSearches() const { return incrementalConnectivity.getNumSearches(); } // Candidate searches of the last incremental update
+
+        // Whether the minimum reassignment spacing has passed since lastAssignedTime, negative meaning never assigned
+        bool isEligibleSH(double lastAssignedTime, double slotStartTime) const { return isEligible(lastAssignedTime, slotStartTime, minReassignmentDurationSH); }
+        bool isEligibleP2P(double lastAssignedTime, double slotStartTime) const { return isEligible(lastAssignedTime, slotStartTime, minReassignmentDurationP2P); }
+
+        SchedulingSnapshotSH createSnapshotSH(const std::vector<int>& bufferStatus, const std::vector<double>& lastAssignedTime, double frameStartTime) const;
+        void assignSlotsSH(const SchedulingSnapshotSH& snapshot, IRandomSource& random, std::vector<std::vector<int>>& nodeSlots);
+
+        // busy marks nodes that cannot take part in a P2P link of this slot, e.g. because they transmit on SH
+        SchedulingSnapshotP2P createSnapshotP2P(const std::vector<int>& bufferStatus, const std::vector<std::vector<P2PDemand>>& destinations,
+                const std::vector<double>& lastAssignedTime, const std::vector<bool>& busy, double slotStartTime) const;
+        void assignLinksP2P(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links);
+
+    protected:
+        // Times closer than half a picosecond, the default simulation time resolution, count as equal
+        static constexpr double TIME_TOLERANCE = 0.5e-12;
+
+        SchedulerCoreParameters parameters;
+        double minReassignmentDurationSH = 0;
+        double minReassignmentDurationP2P = 0;
+        ISchedulingPolicySH *policySH = nullptr;
+        ISchedulingPolicyP2P *policyP2P = nullptr;
+
+        SpatialGrid spatialGrid; // Uniform grid with cell size equal to the communication range
+        IncrementalConnectivity incrementalConnectivity; // Candidate neighbour lists kept across rebuilds in incremental mode
+        ConnectivityGraph graph; // Sparse neighbour lists of all active nodes
+        ConflictSets conflictSets; // 1-hop and 2-hop neighbourhood bitsets, indexed like the graph
+        std::vector<int> graphNodeIds; // Graph index to node ID
+        std::vector<int> graphIndices; // Node ID to graph index, -1 if not in the graph
+        std::vector<NodePosition> graphPositions; // Positions of the graph nodes at the last build
+        bool spatialGridValid = false; // Whether spatialGrid holds graphPositions, the incremental mode does not need it for the build
+        std::vector<int> visitMarks; // Per graph index marker used to deduplicate multi-hop neighbourhoods
+        int visitStamp = 0;
+        std::vector<std::pair<int, int>> edges;
+
+        static bool isEligible(double lastAssignedTime, double slotStartTime, double minDuration) {
+            return lastAssignedTime < 0 || slotStartTime - lastAssignedTime >= minDuration - TIME_TOLERANCE;
+        }
+};
+
+#endif
@@ -0,0 +1,103 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SchedulingPolicy.h"
+#include "GreedySlotColouring.h"
+#include "MatchingPolicy.h"
+#include "MaxWeightPolicy.h"
+#include "ProportionalFairPolicy.h"
+#include "RandomPolicy.h"
+#include <algorithm>
+
+void FrameStateSH::reset(const SchedulingSnapshotSH& snapshot, std::vector<std::vector<int>>& nodeSlots) {
+    minSpacingSlots = std::max(1, snapshot.minSpacingSlots);
+    remaining = snapshot.bufferStatus;
+    nextAllowedSlot = snapshot.firstEligibleSlot;
+    nodeSlots.assign(remaining.size(), std::vector<int>());
+}
+
+void FrameStateSH::collectCandidates(int slot, NodeBitset& candidates) const {
+    candidates.resize((int)remaining.size());
+    for (int v = 0; v < (int)remaining.size(); ++v) {
+        if (remaining[v] > 0 && nextAllowedSlot[v] <= slot) {
+            candidates.set(v);
+        }
+    }
+}
+
+void FrameStateSH::assign(int node, int slot, std::vector<std::vector<int>>& nodeSlots) {
+    nodeSlots[node].push_back(slot);
+    --remaining[node];
+    nextAllowedSlot[node] = slot + minSpacingSlots;
+}
+
+void SlotStateP2P::reset(const SchedulingSnapshotP2P& snapshot) {
+    used.assign(snapshot.busySH.size(), false);
+}
+
+bool SlotStateP2P::isFeasible(const SchedulingSnapshotP2P& snapshot, int transmitter, int recipient) const {
+    if (recipient < 0 || recipient == transmitter) {
+        return false;
+    }
+    return !isBlocked(snapshot, transmitter) && !isBlocked(snapshot, recipient);
+}
+
+void SlotStateP2P::assign(int transmitter, int recipient, std::vector<P2PLink>& links) {
+    used[transmitter] = true;
+    used[recipient] = true;
+    links.push_back(P2PLink{transmitter, recipient});
+}
+
+int SlotStateP2P::findFeasibleRecipient(const SchedulingSnapshotP2P& snapshot, int transmitter) const {
+    for (const P2PDemand& demand : snapshot.demands[transmitter]) {
+        if (isFeasible(snapshot, transmitter, demand.recipient)) {
+            return demand.recipient;
+        }
+    }
+    return -1;
+}
+
+ISchedulingPolicySH *createSchedulingPolicySH(const std::string& name, const SchedulingPolicyParameters& parameters) {
+    if (name == "random") {
+        return new RandomPolicySH();
+    }
+    if (name == "maxWeight") {
+        return new MaxWeightPolicySH();
+    }
+    if (name == "proportionalFair") {
+        return new ProportionalFairPolicySH(parameters.fairnessWindowSlots);
+    }
+    if (name == "greedyColouring") {
+        return new GreedySlotColouring();
+    }
+    return nullptr;
+}
+
+ISchedulingPolicyP2P *createSchedulingPolicyP2P(const std::string& name, const SchedulingPolicyParameters& parameters) {
+    if (name == "random") {
+        return new RandomPolicyP2P();
+    }
+    if (name == "maxWeight") {
+        return new MaxWeightPolicyP2P();
+    }
+    if (name == "proportionalFair") {
+        return new ProportionalFairPolicyP2P(parameters.fairnessWindowSlots);
+    }
+    if (name == "matching") {
+        return new MatchingPolicyP2P();
+    }
+    return nullptr;
+}
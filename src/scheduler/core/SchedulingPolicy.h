@@ -0,0 +1,142 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_SCHEDULING_POLICY_H
+#define __INET_SCHEDULING_POLICY_H
+
+#include "ConflictSets.h"
+#include "NodeBitset.h"
+#include <string>
+#include <vector>
+
+/** @brief Source of uniformly distributed integers, so policies can draw from the simulation's RNG streams. */
+class IRandomSource
+{
+    public:
+        virtual ~IRandomSource() {}
+        virtual int uniformInt(int low, int high) = 0; // Inclusive on both ends
+};
+
+/** @brief Immutable scheduler state handed to an SH policy for the assignment of one frame.
+ *
+ * Per-node vectors are indexed by graph index, like the conflict sets.
+ */
+struct SchedulingSnapshotSH
+{
+    const ConflictSets *conflicts = nullptr; // Nodes that must not share an SH slot
+    std::vector<int> nodeIds; // Graph index to node ID
+    std::vector<int> bufferStatus; // Reported SH backlog in packets
+    std::vector<double> lastAssignedTime; // Start of the last SH slot in seconds, negative if never assigned
+    std::vector<int> firstEligibleSlot; // First slot of the frame the node may use, numSlots if none
+    int numSlots = 0; // Slots in the frame
+    int minSpacingSlots = 1; // Minimum distance between two slots of the same node
+    double frameStartTime = 0;
+    double slotDuration = 0;
+};
+
+/** @brief Packets a transmitter has queued for one recipient. */
+struct P2PDemand
+{
+    int recipient; // Node ID
+    int backlog; // Packets
+};
+
+/** @brief Immutable scheduler state handed to a P2P policy for the assignment of one slot.
+ *
+ * Per-node vectors are indexed by node ID.
+ */
+struct SchedulingSnapshotP2P
+{
+    std::vector<int> candidates; // Ascending IDs of nodes with P2P backlog that may transmit in the slot
+    std::vector<std::vector<P2PDemand>> demands; // Per node ID: per-destination backlog in round-robin order (last served comes last), empty for non-candidates
+    std::vector<int> bufferStatus; // Reported P2P backlog in packets
+    std::vector<double> lastAssignedTime; // Start of the last P2P slot in seconds, negative if never assigned
+    std::vector<bool> busySH; // Node transmits on the SH channel or holds a reserved P2P link in this slot
+    int maxLinks = 0; // Maximum number of links in the slot
+    double slotStartTime = 0;
+};
+
+struct P2PLink
+{
+    int transmitter;
+    int recipient;
+};
+
+/** @brief Decides which nodes transmit in which SH slot of a frame.
+ *
+ * nodeSlots[v] receives the ascending slots assigned to graph index v. Assigned
+ * nodes must not conflict in a slot, must respect firstEligibleSlot and
+ * minSpacingSlots and get at most bufferStatus slots.
+ */
+class ISchedulingPolicySH
+{
+    public:
+        virtual ~ISchedulingPolicySH() {}
+        virtual void assignSlots(const SchedulingSnapshotSH& snapshot, IRandomSource& random, std::vector<std::vector<int>>& nodeSlots) = 0;
+};
+
+/** @brief Decides which P2P links are used in a slot.
+ *
+ * Every link serves one of the transmitter's demands, every node takes part in
+ * at most one link, neither end of a link may be busy on the SH channel and at
+ * most maxLinks links are returned. The links vector is cleared first.
+ */
+class ISchedulingPolicyP2P
+{
+    public:
+        virtual ~ISchedulingPolicyP2P() {}
+        virtual void assignLinks(const SchedulingSnapshotP2P& snapshot, IRandomSource& random, std::vector<P2PLink>& links) = 0;
+};
+
+struct SchedulingPolicyParameters
+{
+    int fairnessWindowSlots = 100; // Averaging window of the proportional-fair policies
+};
+
+/** @brief Unserved backlog and reassignment spacing of every node while an SH policy fills a frame. */
+class FrameStateSH
+{
+    public:
+        void reset(const SchedulingSnapshotSH& snapshot, std::vector<std::vector<int>>& nodeSlots);
+        void collectCandidates(int slot, NodeBitset& candidates) const; // Nodes with backlog that may use the slot
+        void assign(int node, int slot, std::vector<std::vector<int>>& nodeSlots);
+        int getRemaining(int node) const { return remaining[node]; }
+
+    protected:
+        int minSpacingSlots = 1;
+        std::vector<int> remaining;
+        std::vector<int> nextAllowedSlot;
+};
+
+/** @brief Tracks the nodes already used in a P2P slot and checks the link constraints. */
+class SlotStateP2P
+{
+    public:
+        void reset(const SchedulingSnapshotP2P& snapshot);
+        bool isFeasible(const SchedulingSnapshotP2P& snapshot, int transmitter, int recipient) const; // Both ends free and not on the SH channel
+        bool isBlocked(const SchedulingSnapshotP2P& snapshot, int node) const { return snapshot.busySH[node] || used[node]; }
+        void assign(int transmitter, int recipient, std::vector<P2PLink>& links);
+        int findFeasibleRecipient(const SchedulingSnapshotP2P& snapshot, int transmitter) const; // First feasible demand in round-robin order, -1 if none
+
+    protected:
+        std::vector<bool> used; // Node is transmitter or recipient of a link in this slot
+};
+
+// Returns nullptr for an unknown name
+ISchedulingPolicySH *createSchedulingPolicySH(const std::string& name, const SchedulingPolicyParameters& parameters);
+ISchedulingPolicyP2P *createSchedulingPolicyP2P(const std::string& name, const SchedulingPolicyParameters& parameters);
+
+#endif
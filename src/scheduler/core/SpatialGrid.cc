@@ -0,0 +1,96 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SpatialGrid.h"
+#include "ParallelFor.h"
+
+SpatialGrid::SpatialGrid(double cellSize) {
+    setCellSize(cellSize);
+}
+
+void SpatialGrid::setCellSize(double size) {
+    // A non-positive range only connects co-located nodes, any cell size works for that.
+    // The tiny margin keeps pairs at exactly the range from ending up two cells apart due to rounding.
+    cellSize = size > 0 ? size * (1 + 1e-9) : 1.0;
+    clear();
+}
+
+void SpatialGrid::clear() {
+    cells.clear();
+    numItems = 0;
+}
+
+void SpatialGrid::insert(int item, const NodePosition& position) {
+    cells[cellOf(position)].push_back(item);
+    ++numItems;
+}
+
+bool SpatialGrid::remove(int item, const NodePosition& position) {
+    auto cellIt = cells.find(cellOf(position));
+    if (cellIt == cells.end()) {
+        return false;
+    }
+    std::vector<int>& items = cellIt->second;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i] == item) {
+            // Order inside a cell is irrelevant, swap with the last item and pop
+            items[i] = items.back();
+            items.pop_back();
+            if (items.empty()) {
+                cells.erase(cellIt);
+            }
+            --numItems;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SpatialGrid::build(const std::vector<NodePosition>& positions) {
+    clear();
+    cells.reserve(positions.size());
+    for (int i = 0; i < (int)positions.size(); ++i) {
+        insert(i, positions[i]);
+    }
+}
+
+void SpatialGrid::collectPairsWithinRange(const std::vector<NodePosition>& positions, double range, int numThreads,
+                                          std::vector<std::pair<int, int>>& pairs) const {
+    // Every thread scans a contiguous block of lower indices into its own buffer
+    numThreads = std::max(1, std::min(numThreads, (int)positions.size()));
+    std::vector<std::vector<std::pair<int, int>>> chunkPairs(numThreads);
+    parallelFor((int)positions.size(), numThreads, [&](int chunk, int begin, int end) {
+        forEachPairWithinRange(positions, range, begin, end, [&](int i, int j) {
+            chunkPairs[chunk].emplace_back(i, j);
+        });
+    });
+
+    // Concatenating in block order reproduces the serial order
+    size_t total = pairs.size();
+    for (const auto& chunk : chunkPairs) {
+        total += chunk.size();
+    }
+    pairs.reserve(total);
+    for (const auto& chunk : chunkPairs) {
+        pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    }
+}
+
+SpatialGrid::CellKey SpatialGrid::cellOf(const NodePosition& position) const {
+    return CellKey{(int64_t)std::floor(position.x / cellSize),
+                   (int64_t)std::floor(position.y / cellSize),
+                   (int64_t)std::floor(position.z / cellSize)};
+}
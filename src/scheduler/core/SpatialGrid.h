@@ -0,0 +1,142 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef __INET_SPATIAL_GRID_H
+#define __INET_SPATIAL_GRID_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** @brief Plain 3D position snapshot of a node, decoupled from the INET mobility model. */
+struct NodePosition
+{
+    double x = 0;
+    double y = 0;
+    double z = 0;
+
+    NodePosition() {}
+    NodePosition(double x, double y, double z) : x(x), y(y), z(z) {}
+
+    // Same arithmetic as inet::Coord::distance() so range checks give identical results
+    double distance(const NodePosition& other) const {
+        double dx = x - other.x;
+        double dy = y - other.y;
+        double dz = z - other.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+};
+
+/** @brief Uniform hash grid used as neighbour-discovery engine for the connectivity graph.
+ *
+ * Items (graph indices) are bucketed into cubic cells of edge length cellSize. With the
+ * cell size equal to the communication range, every pair within range lies in the same
+ * or in directly adjacent cells, so only 27 cells need to be tested per item instead of
+ * all other items.
+ */
+class SpatialGrid
+{
+    public:
+        explicit SpatialGrid(double cellSize = 1.0);
+
+        void setCellSize(double cellSize);
+        double getCellSize() const { return cellSize; }
+
+        void clear();
+        void insert(int item, const NodePosition& position);
+        bool remove(int item, const NodePosition& position); // Position must be the one the item was inserted at
+        void build(const std::vector<NodePosition>& positions); // Inserts item i at positions[i]
+        size_t size() const { return numItems; }
+
+        // Calls visit(item) for every item stored in the 27 cells around the given position
+        template<typename Visitor>
+        void forEachCandidate(const NodePosition& position, Visitor visit) const;
+
+        // Calls visit(i, j) with i < j once for every pair of items within range of each other
+        template<typename Visitor>
+        void forEachPairWithinRange(const std::vector<NodePosition>& positions, double range, Visitor visit) const;
+
+        // Appends all pairs within range, split over numThreads threads. The pair order is the
+        // serial forEachPairWithinRange() order, independent of the number of threads.
+        void collectPairsWithinRange(const std::vector<NodePosition>& positions, double range, int numThreads,
+                                     std::vector<std::pair<int, int>>& pairs) const;
+
+    protected:
+        struct CellKey
+        {
+            int64_t x, y, z;
+            bool operator==(const CellKey& other) const { return x == other.x && y == other.y && z == other.z; }
+        };
+
+        struct CellKeyHash
+        {
+            size_t operator()(const CellKey& key) const {
+                // Large primes as used by common spatial hashing schemes
+                return (size_t)(key.x * 73856093LL) ^ (size_t)(key.y * 19349663LL) ^ (size_t)(key.z * 83492791LL);
+            }
+        };
+
+        double cellSize;
+        size_t numItems = 0;
+        std::unordered_map<CellKey, std::vector<int>, CellKeyHash> cells;
+
+        CellKey cellOf(const NodePosition& position) const;
+
+        // Pairs whose lower index lies in [begin, end)
+        template<typename Visitor>
+        void forEachPairWithinRange(const std::vector<NodePosition>& positions, double range, int begin, int end, Visitor visit) const;
+};
+
+template<typename Visitor>
+void SpatialGrid::forEachCandidate(const NodePosition& position, Visitor visit) const {
+    CellKey center = cellOf(position);
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+        for (int64_t dy = -1; dy <= 1; ++dy) {
+            for (int64_t dz = -1; dz <= 1; ++dz) {
+                auto cellIt = cells.find(CellKey{center.x + dx, center.y + dy, center.z + dz});
+                if (cellIt == cells.end()) {
+                    continue;
+                }
+                for (int item : cellIt->second) {
+                    visit(item);
+                }
+            }
+        }
+    }
+}
+
+template<typename Visitor>
+void SpatialGrid::forEachPairWithinRange(const std::vector<NodePosition>& positions, double range, Visitor visit) const {
+    forEachPairWithinRange(positions, range, 0, (int)positions.size(), visit);
+}
+
+template<typename Visitor>
+void SpatialGrid::forEachPairWithinRange(const std::vector<NodePosition>& positions, double range, int begin, int end, Visitor visit) const {
+    for (int i = begin; i < end; ++i) {
+        const NodePosition& positionI = positions[i];
+        forEachCandidate(positionI, [&](int j) {
+            // Only report each pair once, from its lower index
+            if (j > i && positionI.distance(positions[j]) <= range) {
+                visit(i, j);
+            }
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,131 @@
+// The LDACS Abstract TDMA MAC models an abstract LDACS air-to-air TDMA-based MAC protocol.
+// Copyright (C) 2024  Musab Ahmed, Konrad Fuger, Koojana Kuladinithi, Andreas Timm-Giel, Institute of Communication Networks, Hamburg University of Technology, Hamburg, Germany
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+// Prints a summary of a binary schedule trace written by AbstractLdacsTdmaScheduler
+// (parameter scheduleTraceFile) and, with -d, every record as text.
+//
+// Usage: scheduleTraceReader [-d] <trace file>
+
+#include "scheduler/core/ScheduleTrace.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static void countTransmissions(std::vector<long>& counts, int nodeId) {
+    if (nodeId >= (int)counts.size()) {
+        counts.resize(nodeId + 1, 0);
+    }
+    ++counts[nodeId];
+}
+
+int main(int argc, char **argv) {
+    bool dump = false;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-d") == 0) {
+            dump = true;
+        }
+        else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::fprintf(stderr, "usage: %s [-d] <trace file>\n", argv[0]);
+        return 2;
+    }
+
+    ScheduleTraceReader reader;
+    if (!reader.open(path)) {
+        std::fprintf(stderr, "%s: %s\n", path, reader.getError().c_str());
+        return 1;
+    }
+
+    long framesSH = 0, grantsSH = 0, passesP2P = 0, slotsP2P = 0;
+    long transmissionsSH = 0, linksP2P = 0;
+    std::vector<long> nodeTransmissionsSH, nodeLinksP2P;
+    for (ScheduleTrace::RecordType type = reader.next(); type != ScheduleTrace::END; type = reader.next()) {
+        if (type == ScheduleTrace::FRAME_SH) {
+            const ScheduleTraceFrameSH& frame = reader.getFrameSH();
+            ++framesSH;
+            if (dump) {
+                std::printf("SH frame at slot %d, %zu nodes\n", frame.frameStartSlot, frame.bufferStatus.size());
+            }
+            for (size_t slot = 0; slot < frame.slotNodes.size(); ++slot) {
+                if (dump && !frame.slotNodes[slot].empty()) {
+                    std::printf("  slot %zu:", slot);
+                    for (int nodeId : frame.slotNodes[slot]) {
+                        std::printf(" %d", nodeId);
+                    }
+                    std::printf("\n");
+                }
+                for (int nodeId : frame.slotNodes[slot]) {
+                    countTransmissions(nodeTransmissionsSH, nodeId);
+                    ++transmissionsSH;
+                }
+            }
+        }
+        else if (type == ScheduleTrace::GRANT_SH) {
+            const ScheduleTraceFrameSH& frame = reader.getFrameSH();
+            ++grantsSH;
+            if (dump) {
+                std::printf("SH mid-frame grant at tick %lld for node %d:", (long long)frame.grantTime, frame.nodeId);
+                for (int slot : frame.localSlots) {
+                    std::printf(" %d", slot);
+                }
+                std::printf("\n");
+            }
+            for (size_t i = 0; i < frame.localSlots.size(); ++i) {
+                countTransmissions(nodeTransmissionsSH, frame.nodeId);
+                ++transmissionsSH;
+            }
+        }
+        else if (type == ScheduleTrace::PASS_P2P) {
+            const ScheduleTracePassP2P& pass = reader.getPassP2P();
+            ++passesP2P;
+            slotsP2P += pass.slotLinks.size();
+            for (size_t offset = 0; offset < pass.slotLinks.size(); ++offset) {
+                if (dump && !pass.slotLinks[offset].empty()) {
+                    std::printf("P2P slot %zu:", pass.firstSlot + offset);
+                    for (const P2PLink& link : pass.slotLinks[offset]) {
+                        std::printf(" %d->%d", link.transmitter, link.recipient);
+                    }
+                    std::printf("\n");
+                }
+                for (const P2PLink& link : pass.slotLinks[offset]) {
+                    countTransmissions(nodeLinksP2P, link.transmitter);
+                    ++linksP2P;
+                }
+            }
+        }
+    }
+
+    std::printf("SH: %ld frames, %ld mid-frame grants, %ld transmissions\n", framesSH, grantsSH, transmissionsSH);
+    std::printf("P2P: %ld passes, %ld slots, %ld links\n", passesP2P, slotsP2P, linksP2P);
+    size_t numNodes = std::max(nodeTransmissionsSH.size(), nodeLinksP2P.size());
+    nodeTransmissionsSH.resize(numNodes, 0);
+    nodeLinksP2P.resize(numNodes, 0);
+    std::printf("node  SH slots  P2P slots\n");
+    for (size_t nodeId = 0; nodeId < numNodes; ++nodeId) {
+        std::printf("%4zu  %8ld  %9ld\n", nodeId, nodeTransmissionsSH[nodeId], nodeLinksP2P[nodeId]);
+    }
+    if (!reader.ok()) {
+        std::fprintf(stderr, "%s: %s\n", path, reader.getError().c_str());
+        return 1;
+    }
+    return 0;
+}